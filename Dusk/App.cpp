@@ -1,4 +1,5 @@
 #include <Dusk/App.hpp>
+#include <Dusk/Log.hpp>
 #include <format>
 #include <glm/ext/matrix_clip_space.hpp>
 #include <glm/ext/matrix_transform.hpp>
@@ -7,34 +8,53 @@
 #define GLFW_EXPOSE_NATIVE_X11
 #include <GLFW/glfw3native.h>
 
-#include <iostream>
-
-#define PRINT(status, type, msg) \
-  std::cout << "[" << status << "] " << type << " - " << msg << std::endl
-#define LOG_WGPU(msg) PRINT("INFO", "Dawn::WebGPU", msg)
-#define LOG_GLFW(msg) PRINT("INFO", "GLFW", msg)
-#define ERR_WGPU(msg) PRINT("ERROR", "Dawn::WebGPU", msg)
-#define ERR_GLFW(msg) PRINT("ERROR", "GLFW", msg)
-#define SUCCESS_WGPU(msg) PRINT("SUCCESS", "Dawn::WebGPU", msg)
-#define SUCCESS_GLFW(msg) PRINT("SUCCESS", "GLFW", msg)
+#define LOG_WGPU(msg) DUSK_LOG(LogLevel::Info, "Dawn::WebGPU", msg)
+#define LOG_GLFW(msg) DUSK_LOG(LogLevel::Info, "GLFW", msg)
+#define ERR_WGPU(msg) DUSK_LOG(LogLevel::Error, "Dawn::WebGPU", msg)
+#define ERR_GLFW(msg) DUSK_LOG(LogLevel::Error, "GLFW", msg)
+#define SUCCESS_WGPU(msg) DUSK_LOG(LogLevel::Success, "Dawn::WebGPU", msg)
+#define SUCCESS_GLFW(msg) DUSK_LOG(LogLevel::Success, "GLFW", msg)
 
 namespace Dusk {
 
+// seconds between duty cycle reports
+static constexpr double DUTY_REPORT_INTERVAL = 5.0;
+
 App::App() {
+  phaseStart = std::chrono::steady_clock::now();
+  createInstance();
+
+  // the adapter and device only need the instance, so they are requested
+  // while GLFW and the window come up. Nothing else uses the instance until
+  // the request is joined, the surface is created and checked against the
+  // adapter after that.
+  deviceRequest = std::thread([this]() {
+    auto start = std::chrono::steady_clock::now();
+    requestAdapter(nullptr);
+    requestDevice();
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    deviceRequestMs = elapsed.count();
+  });
+
   LOG_GLFW("Initializing GLFW...");
   glfwInitialized = glfwInit();
   if (!glfwInitialized) {
-    std::cerr << "Unable to initialize GLFW." << std::endl;
+    ERR_GLFW("Unable to initialize GLFW.");
     std::exit(1);
   }
   SUCCESS_GLFW("Successfully initialized GLFW");
-  createInstance();
+  markPhase("instance and GLFW");
 }
 
 App::~App() {
+  if (deviceRequest.joinable()) {
+    deviceRequest.join();
+  }
   updateThread.join();
 
   LOG_WGPU("Releasing WebGPU resources");
+  windows.clear();
   surface = nullptr;
   device = nullptr;
   adapter = nullptr;
@@ -47,6 +67,7 @@ App::~App() {
     glfwTerminate();
   }
   SUCCESS_GLFW("Successfully terminated GLFW");
+  Log::flush();
 }
 
 void App::run(int width, int height) {
@@ -57,48 +78,33 @@ void App::run(int width, int height) {
 
 void App::run() {
   LOG_GLFW("Creating window...");
-  static App *appInstance = this;
   glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
   window = glfwCreateWindow(width, height, "GLFW", nullptr, nullptr);
   SUCCESS_GLFW("Successfully created window");
-  glfwSetKeyCallback(
-      window, [](GLFWwindow *window, int key, [[maybe_unused]] int scancode,
-                 int action, [[maybe_unused]] int mods) {
-        if (action == GLFW_PRESS) {
-          if (key == GLFW_KEY_ESCAPE) {
-            glfwSetWindowShouldClose(window, 1);
-          }
-          appInstance->onKeyPressed(key);
-        }
-      });
+  glfwSetWindowUserPointer(window, this);
+  installCallbacks(window);
+  markPhase("window");
 
-  glfwSetCursorPosCallback(window, []([[maybe_unused]] GLFWwindow *window,
-                                      double xpos, double ypos) {
-    appInstance->onMouseMoved(xpos, ypos);
-    if (appInstance->mousePressed) {
-      appInstance->onMouseDragged(xpos, ypos);
-    }
-  });
+  deviceRequest.join();
+  markPhase("waiting for device");
 
-  glfwSetMouseButtonCallback(window, [](GLFWwindow *window, int button,
-                                        int action, [[maybe_unused]] int mods) {
-    double x = 0;
-    double y = 0;
-    glfwGetCursorPos(window, &x, &y);
-    if (action == GLFW_PRESS) {
-      appInstance->onMousePressed(x, y, button);
-      appInstance->mousePressed = true;
-    }
-    if (action == GLFW_RELEASE) {
-      appInstance->onMouseReleased(x, y, button);
-      appInstance->mousePressed = false;
+  // on this thread only once the device request no longer uses the instance
+  surface = createSurface(window);
+  markPhase("surface");
+  {
+    wgpu::SurfaceCapabilities caps;
+    surface.GetCapabilities(adapter, &caps);
+    if (caps.formatCount == 0) {
+      // the adapter picked without a surface cannot present to it
+      LOG_WGPU("Adapter cannot present to the window, requesting another");
+      device = nullptr;
+      requestAdapter(surface);
+      requestDevice();
+      markPhase("adapter and device for surface");
     }
-  });
+  }
 
-  createSurface();
-  requestAdapter();
-  requestDevice();
-  configureSurface();
+  configureSurface(surface, width, height);
   {
     queue = device.GetQueue();
     if (!queue) {
@@ -110,27 +116,137 @@ void App::run() {
   wgpu::SurfaceCapabilities caps;
   surface.GetCapabilities(adapter, &caps);
 
-  drawer = Dusk::Drawer(device, surface, caps.formats[0]);
+  drawer = Dusk::Drawer(device, surface, caps.formats[0], sampleCount);
+  compute = Dusk::Compute(device);
+  markPhase("drawer");
 
   setup();
+  markPhase("setup");
 
   updateThread = std::thread([this]() {
     while (!glfwWindowShouldClose(window)) {
       update();
+      if (renderOnDemand) {
+        waitForTick();
+      }
     }
   });
 
   while (!glfwWindowShouldClose(window)) {
+    if (renderOnDemand && !redrawDue() && !waitForRedraw()) {
+      continue;
+    }
+    frameStart = std::chrono::steady_clock::now();
+    throttleFrames();
     glfwPollEvents();
     instance.ProcessEvents();
+    // requests made while drawing ask for the frame after this one
+    redrawRequested = false;
     draw();
-    surface.Present();
+    trackFrame();
+    present();
+    measureLatency();
+    trackDutyCycle(frameStart);
+    notifyTick();
+    if (frameNum == 0) {
+      // includes waiting for the pipelines compiled since the drawer
+      markPhase("first frame");
+      reportStartup();
+    }
     frameNum++;
     double currTime = glfwGetTime();
     double deltaTime = currTime - prevTime;
     fps = 1.0 / deltaTime;
     prevTime = currTime;
   }
+  {
+    std::lock_guard lock(tickMutex);
+    stopping = true;
+  }
+  ticked.notify_all();
+}
+
+void App::requestRedraw() {
+  redrawRequested = true;
+  // wakes the main thread from glfwWaitEventsTimeout()
+  glfwPostEmptyEvent();
+}
+
+void App::setAnimating(bool animating) {
+  this->animating = animating;
+  glfwPostEmptyEvent();
+}
+
+void App::animateFor(double seconds) {
+  animateUntil = std::max(animateUntil.load(), glfwGetTime() + seconds);
+  glfwPostEmptyEvent();
+}
+
+bool App::redrawDue() {
+  return redrawRequested || animating || glfwGetTime() < animateUntil;
+}
+
+bool App::waitForRedraw() {
+  auto start = std::chrono::steady_clock::now();
+  double timeout = idleTimeout;
+  const double animationLeft = animateUntil - glfwGetTime();
+  if (animationLeft > 0) {
+    timeout = std::min(timeout, animationLeft);
+  }
+  // input callbacks and requestRedraw() end the wait early
+  glfwWaitEventsTimeout(timeout);
+  instance.ProcessEvents();
+  std::chrono::duration<double, std::milli> waited =
+      std::chrono::steady_clock::now() - start;
+  dutyCycle.idleMs += waited.count();
+  reportDuty();
+  if (redrawDue()) {
+    return true;
+  }
+  dutyCycle.idleWakeups++;
+  // lets update() look for new data while nothing is drawn
+  notifyTick();
+  return false;
+}
+
+void App::waitForTick() {
+  std::unique_lock lock(tickMutex);
+  // ticks that came in while update() ran return right away
+  ticked.wait(lock, [&]() { return ticks != ticksSeen || stopping; });
+  ticksSeen = ticks;
+}
+
+void App::notifyTick() {
+  {
+    std::lock_guard lock(tickMutex);
+    ticks++;
+  }
+  ticked.notify_all();
+}
+
+void App::trackDutyCycle(std::chrono::steady_clock::time_point start) {
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  dutyCycle.activeMs += elapsed.count();
+  dutyCycle.frames++;
+  reportDuty();
+}
+
+void App::reportDuty() {
+  const double now = glfwGetTime();
+  if (!reportDutyCycle || now - lastDutyReport < DUTY_REPORT_INTERVAL) {
+    return;
+  }
+  lastDutyReport = now;
+  DUSK_LOG(LogLevel::Info, "Dusk",
+           std::format("Active {:.1f}% of {:.1f} s, {} frames, {} idle "
+                       "wakeups",
+                       dutyCycle.active() * 100,
+                       (dutyCycle.activeMs + dutyCycle.idleMs) / 1000,
+                       dutyCycle.frames, dutyCycle.idleWakeups));
+  // Info lines are buffered, a report every few seconds would otherwise
+  // take minutes to show up
+  Log::flush();
 }
 
 void App::createInstance() {
@@ -149,7 +265,147 @@ void App::createInstance() {
   SUCCESS_WGPU("Successfully created a WebGPU Instance");
 }
 
-void App::createSurface() {
+void App::installCallbacks(GLFWwindow *window) {
+  glfwSetKeyCallback(
+      window, [](GLFWwindow *window, int key, [[maybe_unused]] int scancode,
+                 int action, [[maybe_unused]] int mods) {
+        if (action == GLFW_PRESS) {
+          if (key == GLFW_KEY_ESCAPE) {
+            glfwSetWindowShouldClose(window, 1);
+          }
+          auto app = static_cast<App *>(glfwGetWindowUserPointer(window));
+          Event event{Event::Type::KeyPressed};
+          event.code = key;
+          event.window = app->windowIndex(window);
+          app->receive(event);
+        }
+      });
+
+  glfwSetCursorPosCallback(
+      window, [](GLFWwindow *window, double xpos, double ypos) {
+        auto app = static_cast<App *>(glfwGetWindowUserPointer(window));
+        Event event{Event::Type::MouseMoved};
+        event.x = xpos;
+        event.y = ypos;
+        event.dragging = app->mousePressed;
+        event.window = app->windowIndex(window);
+        app->receive(event);
+      });
+
+  glfwSetMouseButtonCallback(window, [](GLFWwindow *window, int button,
+                                        int action, [[maybe_unused]] int mods) {
+    if (action != GLFW_PRESS && action != GLFW_RELEASE) {
+      return;
+    }
+    auto app = static_cast<App *>(glfwGetWindowUserPointer(window));
+    Event event{action == GLFW_PRESS ? Event::Type::MousePressed
+                                     : Event::Type::MouseReleased};
+    event.code = button;
+    event.window = app->windowIndex(window);
+    glfwGetCursorPos(window, &event.x, &event.y);
+    app->mousePressed = action == GLFW_PRESS;
+    app->receive(event);
+  });
+
+  // the window was uncovered or needs its contents again
+  glfwSetWindowRefreshCallback(window, [](GLFWwindow *window) {
+    auto app = static_cast<App *>(glfwGetWindowUserPointer(window));
+    app->redrawRequested = true;
+  });
+
+  glfwSetFramebufferSizeCallback(
+      window, [](GLFWwindow *window, int width, int height) {
+        auto app = static_cast<App *>(glfwGetWindowUserPointer(window));
+        app->resizeWindow(window, width, height);
+      });
+}
+
+uint32_t App::windowIndex(GLFWwindow *window) {
+  for (const auto &w : windows) {
+    if (w->window == window) {
+      return w->index;
+    }
+  }
+  return 0;
+}
+
+void App::resizeWindow(GLFWwindow *window, int width, int height) {
+  if (width <= 0 || height <= 0) {
+    // minimized, the surface keeps its size until the window is restored
+    return;
+  }
+  const uint32_t index = windowIndex(window);
+  if (index == 0) {
+    this->width = width;
+    this->height = height;
+    configureSurface(surface, width, height);
+    drawer.resize(width, height);
+  }
+  for (const auto &w : windows) {
+    if (w->index == index) {
+      w->width = width;
+      w->height = height;
+      configureSurface(w->surface, width, height);
+      w->drawer.resize(width, height);
+    }
+  }
+  eventWindow = index;
+  redrawRequested = true;
+  onResized(width, height);
+}
+
+Window &App::createWindow(int width, int height, const std::string &title) {
+  LOG_GLFW(std::format("Creating window {}...", title));
+  auto w = std::unique_ptr<Window>(new Window());
+  w->width = width;
+  w->height = height;
+  w->index = windows.size() + 1;
+
+  glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+  w->window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+  glfwSetWindowUserPointer(w->window, this);
+  installCallbacks(w->window);
+
+  w->surface = createSurface(w->window);
+  configureSurface(w->surface, width, height);
+  wgpu::SurfaceCapabilities caps;
+  w->surface.GetCapabilities(adapter, &caps);
+  // shares pipelines and pooled textures with the main drawer
+  w->drawer = Dusk::Drawer(device, w->surface, caps.formats[0], sampleCount,
+                           drawer.getResources());
+  SUCCESS_GLFW(std::format("Successfully created window {}", title));
+
+  windows.push_back(std::move(w));
+  return *windows.back();
+}
+
+void App::drawWindows() {
+  std::vector<Drawer *> drawers = {&drawer};
+  for (const auto &w : windows) {
+    if (w->isOpen()) {
+      drawers.push_back(&w->drawer);
+    }
+  }
+  Drawer::drawAll(drawers);
+}
+
+void App::present() {
+  surface.Present();
+  for (const auto &w : windows) {
+    if (!w->isOpen()) {
+      if (glfwGetWindowAttrib(w->window, GLFW_VISIBLE)) {
+        glfwHideWindow(w->window);
+      }
+      continue;
+    }
+    // only windows drawn this frame hold a surface texture to present
+    if (w->drawer.getLastSubmitTime() >= frameStart) {
+      w->surface.Present();
+    }
+  }
+}
+
+wgpu::Surface App::createSurface(GLFWwindow *window) {
   LOG_WGPU("Creating surface...");
 
   wgpu::SurfaceDescriptorFromXlibWindow xlibDesc{};
@@ -162,7 +418,7 @@ void App::createSurface() {
   surfaceDesc.nextInChain = &xlibDesc;
   surfaceDesc.label = nullptr;
 
-  surface = instance.CreateSurface(&surfaceDesc);
+  wgpu::Surface surface = instance.CreateSurface(&surfaceDesc);
 
   if (!surface) {
     ERR_WGPU("Unable to create a surface");
@@ -170,11 +426,12 @@ void App::createSurface() {
   }
 
   SUCCESS_WGPU("Succesfully created surface");
+  return surface;
 }
 
-void App::requestAdapter() {
+void App::requestAdapter(wgpu::Surface compatibleSurface) {
   wgpu::RequestAdapterOptions adapterOpts{};
-  adapterOpts.compatibleSurface = surface;
+  adapterOpts.compatibleSurface = compatibleSurface;
 
   wgpu::RequestAdapterCallbackInfo callbackInfo = {};
   callbackInfo.nextInChain = nullptr;
@@ -200,6 +457,12 @@ void App::requestAdapter() {
 
 void App::requestDevice() {
   wgpu::DeviceDescriptor deviceDesc{};
+  // lets dynamic resolution measure the GPU's own frame time
+  const wgpu::FeatureName timestamps = wgpu::FeatureName::TimestampQuery;
+  if (adapter.HasFeature(timestamps)) {
+    deviceDesc.requiredFeatureCount = 1;
+    deviceDesc.requiredFeatures = &timestamps;
+  }
 
   wgpu::RequestDeviceCallbackInfo deviceCallbackInfo{};
   deviceCallbackInfo.userdata = &device;
@@ -222,7 +485,7 @@ void App::requestDevice() {
                    UINT64_MAX);
 }
 
-void App::configureSurface() {
+void App::configureSurface(wgpu::Surface &surface, int width, int height) {
   LOG_WGPU("Configuring surface...");
 
   wgpu::SurfaceCapabilities caps;
@@ -236,6 +499,14 @@ void App::configureSurface() {
   config.format = caps.formats[0];
   config.usage = wgpu::TextureUsage::RenderAttachment;
   config.presentMode = wgpu::PresentMode::Fifo;
+  for (size_t i = 0; i < caps.presentModeCount; i++) {
+    if (caps.presentModes[i] == presentMode) {
+      config.presentMode = presentMode;
+    }
+  }
+  if (config.presentMode != presentMode) {
+    LOG_WGPU("Requested present mode unsupported, falling back to Fifo");
+  }
   config.viewFormatCount = 0;
   config.viewFormats = nullptr;
 
@@ -243,4 +514,120 @@ void App::configureSurface() {
   SUCCESS_WGPU("Successfully configured surface");
 }
 
+void App::receive(Event event) {
+  markInput();
+  redrawRequested = true;
+  event.time = std::chrono::steady_clock::now();
+  if (inputMode == InputMode::Queued) {
+    eventQueue.push(event);
+  } else {
+    handleEvent(event);
+  }
+}
+
+void App::handleEvent(const Event &event) {
+  eventWindow = event.window;
+  switch (event.type) {
+    case Event::Type::KeyPressed:
+      onKeyPressed(event.code);
+      break;
+    case Event::Type::MouseMoved:
+      onMouseMoved(event.x, event.y);
+      if (event.dragging) {
+        onMouseDragged(event.x, event.y);
+      }
+      break;
+    case Event::Type::MousePressed:
+      onMousePressed(event.x, event.y, event.code);
+      break;
+    case Event::Type::MouseReleased:
+      onMouseReleased(event.x, event.y, event.code);
+      break;
+  }
+}
+
+void App::dispatchEvents() {
+  eventQueue.drain([this](const Event &event) { handleEvent(event); });
+}
+
+void App::markInput() {
+  if (!inputPending) {
+    inputPending = true;
+    inputTime = std::chrono::steady_clock::now();
+  }
+}
+
+void App::throttleFrames() {
+  if (maxFramesInFlight == 0) {
+    return;
+  }
+  while (framesInFlight.size() >= maxFramesInFlight) {
+    instance.WaitAny(framesInFlight.front(), UINT64_MAX);
+    framesInFlight.pop_front();
+  }
+}
+
+void App::trackFrame() {
+  if (maxFramesInFlight == 0) {
+    return;
+  }
+  wgpu::QueueWorkDoneCallbackInfo callbackInfo{};
+  callbackInfo.mode = wgpu::CallbackMode::WaitAnyOnly;
+  callbackInfo.callback = []([[maybe_unused]] WGPUQueueWorkDoneStatus status,
+                             [[maybe_unused]] void *userdata) {};
+  framesInFlight.push_back(queue.OnSubmittedWorkDone(callbackInfo));
+}
+
+void App::measureLatency() {
+  if (!inputPending) {
+    return;
+  }
+  auto submitted = drawer.getLastSubmitTime();
+  if (submitted < inputTime) {
+    // nothing was drawn since the input arrived
+    return;
+  }
+  std::chrono::duration<double, std::milli> toSubmit = submitted - inputTime;
+  std::chrono::duration<double, std::milli> toPresent =
+      std::chrono::steady_clock::now() - inputTime;
+  inputLatency.record(toSubmit.count());
+  presentLatency.record(toPresent.count());
+  inputPending = false;
+
+  if (reportLatency) {
+    DUSK_LOG(LogLevel::Info, "Dusk",
+             std::format("Frame {} input latency: {:.2f} ms to submit, "
+                         "{:.2f} ms to present",
+                         frameNum, toSubmit.count(), toPresent.count()));
+    Log::flush();
+  }
+}
+
+void App::markPhase(const std::string &name) {
+  auto now = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::milli> elapsed = now - phaseStart;
+  startupPhases.push_back({name, elapsed.count()});
+  phaseStart = now;
+}
+
+void App::reportStartup() {
+  if (!Log::enabled(LogLevel::Info)) {
+    return;
+  }
+  double total = 0;
+  for (const auto &phase : startupPhases) {
+    total += phase.ms;
+  }
+  DUSK_LOG(LogLevel::Info, "Dusk",
+           std::format("Startup took {:.1f} ms", total));
+  for (const auto &phase : startupPhases) {
+    DUSK_LOG(LogLevel::Info, "Dusk",
+             std::format("  {:<32}{:>8.1f} ms", phase.name, phase.ms));
+  }
+  DUSK_LOG(LogLevel::Info, "Dusk",
+           std::format("  {:<32}{:>8.1f} ms", "adapter and device (overlap)",
+                       deviceRequestMs));
+  Log::flush();
+}
+
 }  // namespace Dusk
\ No newline at end of file
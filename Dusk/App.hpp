@@ -3,12 +3,66 @@
 #include <GLFW/glfw3.h>
 #include <webgpu/webgpu_cpp.h>
 
+#include <Dusk/Compute.hpp>
 #include <Dusk/Drawer.hpp>
+#include <Dusk/EventQueue.hpp>
+#include <Dusk/Window.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace Dusk {
 
+struct LatencyStats {
+  double lastMs = 0;
+  double averageMs = 0;
+  double maxMs = 0;
+  uint64_t samples = 0;
+
+  inline void record(double ms) {
+    lastMs = ms;
+    maxMs = samples == 0 ? ms : std::max(maxMs, ms);
+    samples++;
+    averageMs += (ms - averageMs) / samples;
+  }
+};
+
+// How the main loop spent its time since run(): drawing and presenting
+// frames or waiting for a reason to draw one, see App::setRenderOnDemand().
+struct DutyCycle {
+  double activeMs = 0;
+  double idleMs = 0;
+  uint64_t frames = 0;
+  // waits that ended without anything to draw
+  uint64_t idleWakeups = 0;
+
+  // fraction of the time spent on frames
+  inline double active() const {
+    const double total = activeMs + idleMs;
+    return total > 0 ? activeMs / total : 0;
+  }
+};
+
+struct StartupPhase {
+  std::string name;
+  double ms = 0;
+};
+
+enum class InputMode {
+  // handlers run inside glfwPollEvents()
+  Immediate,
+  // events are queued until dispatchEvents() or events().drain()
+  Queued
+};
+
 class App {
  public:
   App();
@@ -33,6 +87,11 @@ class App {
   virtual void onMouseDragged([[maybe_unused]] double mouseX,
                               [[maybe_unused]] double mouseY) {};
 
+  // Called once the surface and drawer of a resized window follow its new
+  // size in pixels, see getEventWindow() for which window it was.
+  virtual void onResized([[maybe_unused]] int width,
+                         [[maybe_unused]] int height) {};
+
   inline int getWidth() {
     return width;
   }
@@ -53,6 +112,94 @@ class App {
     return fps;
   }
 
+  // MSAA sample count of the drawer, 1 disables MSAA. Call before run().
+  inline void setSampleCount(uint32_t count) {
+    sampleCount = count;
+  }
+
+  // Falls back to Fifo if the surface does not support the mode. Call before
+  // run().
+  inline void setPresentMode(wgpu::PresentMode mode) {
+    presentMode = mode;
+  }
+
+  // Blocks before polling input until at most this many submitted frames are
+  // still being processed by the GPU. 0 leaves queueing to the driver.
+  inline void setMaxFramesInFlight(uint32_t frames) {
+    maxFramesInFlight = frames;
+  }
+
+  // Call before run().
+  inline void setInputMode(InputMode mode) {
+    inputMode = mode;
+  }
+
+  // Prints the input latency of every frame that handled input.
+  inline void setReportLatency(bool report) {
+    reportLatency = report;
+  }
+
+  // Draws only when input arrived, requestRedraw() was called or an
+  // animation is running, sleeping in between instead of drawing every
+  // frame. update() then runs once per frame and whenever the loop wakes up
+  // while idle. Call before run().
+  inline void setRenderOnDemand(bool onDemand) {
+    renderOnDemand = onDemand;
+  }
+
+  // Longest sleep while idle, so GPU callbacks and update() still run.
+  inline void setIdleTimeout(double seconds) {
+    idleTimeout = seconds;
+  }
+
+  // Asks for another frame in render on demand mode. Safe to call from any
+  // thread, e.g. from update() when new data came in.
+  void requestRedraw();
+
+  // Keeps drawing every frame while set, e.g. during a transition.
+  void setAnimating(bool animating);
+
+  // Keeps drawing every frame for the next seconds.
+  void animateFor(double seconds);
+
+  inline const DutyCycle& getDutyCycle() {
+    return dutyCycle;
+  }
+
+  // Logs the duty cycle every few seconds.
+  inline void setReportDutyCycle(bool report) {
+    reportDutyCycle = report;
+  }
+
+  // Time from the first input event of a frame until its work was submitted.
+  inline const LatencyStats& getInputLatency() {
+    return inputLatency;
+  }
+
+  // Time from the first input event of a frame until it was presented.
+  inline const LatencyStats& getPresentLatency() {
+    return presentLatency;
+  }
+
+  // Time spent in each phase from the constructor until the first frame was
+  // presented, logged at LogLevel::Info after that frame. Phases run one
+  // after the other, except for the adapter and device request which runs
+  // alongside GLFW and window creation.
+  inline const std::vector<StartupPhase>& getStartupPhases() {
+    return startupPhases;
+  }
+
+  // Opens another window on the App's device. Call from setup() or later.
+  // Input from it reaches the same handlers, see getEventWindow().
+  Window& createWindow(int width, int height,
+                       const std::string& title = "Dusk");
+
+  // Index of the window the event being handled came from, see
+  // Window::getIndex().
+  inline uint32_t getEventWindow() {
+    return eventWindow;
+  }
+
  protected:
   wgpu::Instance instance;
   wgpu::Surface surface;
@@ -60,6 +207,19 @@ class App {
   wgpu::Device device;
   wgpu::Queue queue;
   Dusk::Drawer drawer;
+  Dusk::Compute compute;
+
+  // Runs the input handlers for every queued event. In InputMode::Queued
+  // this, or draining events() directly, must only happen on one thread.
+  void dispatchEvents();
+
+  inline EventQueue& events() {
+    return eventQueue;
+  }
+
+  // Draws the main drawer and the drawers of all open windows with a single
+  // submit. Use instead of drawer.draw() once there are several windows.
+  void drawWindows();
 
  private:
   int width = 1280;
@@ -67,15 +227,73 @@ class App {
   uint64_t frameNum = 0;
   double prevTime = 0;
   double fps = 0;
+  uint32_t sampleCount = 4;
+  wgpu::PresentMode presentMode = wgpu::PresentMode::Fifo;
+  uint32_t maxFramesInFlight = 0;
+  std::deque<wgpu::Future> framesInFlight;
+
+  InputMode inputMode = InputMode::Immediate;
+  EventQueue eventQueue;
+
+  bool reportLatency = false;
+  bool inputPending = false;
+  std::chrono::steady_clock::time_point inputTime;
+  LatencyStats inputLatency;
+  LatencyStats presentLatency;
+  bool renderOnDemand = false;
+  double idleTimeout = 0.25;
+  std::atomic<bool> redrawRequested{true};
+  std::atomic<bool> animating{false};
+  // glfwGetTime() until which animateFor() keeps drawing
+  std::atomic<double> animateUntil{0};
+  DutyCycle dutyCycle;
+  bool reportDutyCycle = false;
+  double lastDutyReport = 0;
+  // frames drawn and idle wakeups, each lets the update thread run once in
+  // render on demand mode
+  std::mutex tickMutex;
+  std::condition_variable ticked;
+  uint64_t ticks = 0;
+  // ticks the update thread has run for
+  uint64_t ticksSeen = 0;
+  bool stopping = false;
+
   int glfwInitialized = false;
   GLFWwindow* window;
+  std::vector<std::unique_ptr<Window>> windows;
+  uint32_t eventWindow = 0;
+  std::chrono::steady_clock::time_point frameStart;
   std::thread updateThread;
+  std::thread deviceRequest;
+  double deviceRequestMs = 0;
+  std::chrono::steady_clock::time_point phaseStart;
+  std::vector<StartupPhase> startupPhases;
 
   void createInstance();
-  void createSurface();
-  void requestAdapter();
+  wgpu::Surface createSurface(GLFWwindow* window);
+  void requestAdapter(wgpu::Surface compatibleSurface);
   void requestDevice();
-  void configureSurface();
+  void configureSurface(wgpu::Surface& surface, int width, int height);
+  void installCallbacks(GLFWwindow* window);
+  uint32_t windowIndex(GLFWwindow* window);
+  void resizeWindow(GLFWwindow* window, int width, int height);
+  void present();
+  void receive(Event event);
+  void handleEvent(const Event& event);
+  void markInput();
+  void throttleFrames();
+  void trackFrame();
+  void measureLatency();
+  bool redrawDue();
+  // Sleeps until there is something to draw, returning false when the wait
+  // ended without.
+  bool waitForRedraw();
+  void waitForTick();
+  void notifyTick();
+  void trackDutyCycle(std::chrono::steady_clock::time_point start);
+  void reportDuty();
+  void markPhase(const std::string& name);
+  void reportStartup();
 
   virtual void setup() {};
   virtual void update() {};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include <span>
+
+namespace Dusk {
+
+// One frame of tessellated shapes, laid out like the drawer's vertex
+// buffers. Vertex i sits at transform * models[vertexModels[i]] *
+// vertices[3i..3i+2] and has the color colors[4i..4i+3].
+struct BackendFrame {
+  uint32_t width;
+  uint32_t height;
+  std::span<const float> vertices;
+  std::span<const float> colors;
+  std::span<const uint32_t> vertexModels;
+  // triangle list, drawn in order
+  std::span<const uint32_t> indices;
+  std::span<const glm::mat4> models;
+  glm::mat4 transform;
+  // whether the target is cleared to clearColor before drawing, otherwise
+  // the frame is drawn over the previous one
+  bool clear;
+  glm::vec4 clearColor;
+};
+
+// Draws the frames of a drawer created with a backend instead of a device,
+// see Drawer::Drawer(std::shared_ptr<RenderBackend>, uint32_t, uint32_t).
+class RenderBackend {
+ public:
+  virtual ~RenderBackend() = default;
+  // The spans are only valid during the call.
+  virtual void draw(const BackendFrame& frame) = 0;
+};
+
+}  // namespace Dusk
@@ -0,0 +1,349 @@
+#include <Dusk/Batch.hpp>
+#include <Dusk/Simd.hpp>
+#include <algorithm>
+#include <numbers>
+
+namespace Dusk::Batch {
+
+using Simd::Float4;
+using Simd::Lanes;
+
+// spread the lattice coordinates of each dimension over the hash input
+static constexpr uint32_t PRIMES[4] = {0x9e3779b1, 0x85ebca77, 0xc2b2ae3d,
+                                       0x27d4eb2f};
+// bring the noise of each dimension to roughly [-1, 1]
+static constexpr float NOISE_SCALE[4] = {2.15, 1.36, 1.15, 1.2};
+// 2 * pi split into a part that multiplies exactly and the rest
+static constexpr float TWO_PI_HIGH = 6.28125;
+static constexpr float TWO_PI_LOW = 1.9353071795864769e-3;
+static constexpr float PI = std::numbers::pi_v<float>;
+
+// lowbias32 by Chris Wellons, every output bit depends on every input bit
+template <typename U>
+static U mix(U h) {
+  h = h ^ (h >> 16);
+  h = h * U(0x7feb352d);
+  h = h ^ (h >> 15);
+  h = h * U(0x846ca68b);
+  return h ^ (h >> 16);
+}
+
+template <typename T>
+static T fade(T t) {
+  return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+template <size_t D, typename T>
+static T gradientNoise(const T* p, uint32_t seed) {
+  using U = typename Lanes<T>::Int;
+  T f[D];
+  T u[D];
+  U cell[D];
+  for (size_t k = 0; k < D; k++) {
+    T i = Simd::floor(p[k]);
+    f[k] = p[k] - i;
+    u[k] = fade(f[k]);
+    cell[k] = Simd::toInt(i) * U(PRIMES[k]);
+  }
+
+  // each corner's gradient, one byte per component, dotted with the offset
+  // to the corner
+  T values[1 << D];
+  for (uint32_t c = 0; c < (1u << D); c++) {
+    U h = seed;
+    for (size_t k = 0; k < D; k++) {
+      h = h + ((c >> k) & 1 ? cell[k] + U(PRIMES[k]) : cell[k]);
+    }
+    h = mix(h);
+    T dot = 0.0f;
+    for (size_t k = 0; k < D; k++) {
+      T g = Simd::toFloat((h >> (8 * k)) & U(255)) * (1.0f / 127.5f) - 1.0f;
+      dot = dot + g * ((c >> k) & 1 ? f[k] - 1.0f : f[k]);
+    }
+    values[c] = dot;
+  }
+
+  // blended one dimension at a time, the last one first
+  for (size_t k = D; k-- > 0;) {
+    for (uint32_t c = 0; c < (1u << k); c++) {
+      values[c] = values[c] + (values[c + (1u << k)] - values[c]) * u[k];
+    }
+  }
+  return values[0] * NOISE_SCALE[D - 1];
+}
+
+template <typename T>
+static T sine(T x) {
+  // x = k * 2pi + r with r in [-pi, pi], then folded into [-pi/2, pi/2]
+  const T k = Simd::floor(x * (0.5f / PI) + 0.5f);
+  T r = x - k * TWO_PI_HIGH - k * TWO_PI_LOW;
+  r = Simd::select(r > PI * 0.5f, PI - r,
+                   Simd::select(r < PI * -0.5f, -PI - r, r));
+  // Taylor series, the next term is below 6e-8 in that range
+  const T r2 = r * r;
+  return r * (1.0f +
+              r2 * (-1.0f / 6 +
+                    r2 * (1.0f / 120 +
+                          r2 * (-1.0f / 5040 +
+                                r2 * (1.0f / 362880 +
+                                      r2 * (-1.0f / 39916800))))));
+}
+
+template <typename T>
+static T eased(Ease curve, T t) {
+  t = Simd::min(Simd::max(t, T(0.0f)), T(1.0f));
+  const T s = 1.0f - t;
+  switch (curve) {
+    case Ease::Linear:
+      return t;
+    case Ease::QuadIn:
+      return t * t;
+    case Ease::QuadOut:
+      return 1.0f - s * s;
+    case Ease::QuadInOut:
+      return Simd::select(t < 0.5f, 2.0f * t * t, 1.0f - 2.0f * s * s);
+    case Ease::CubicIn:
+      return t * t * t;
+    case Ease::CubicOut:
+      return 1.0f - s * s * s;
+    case Ease::CubicInOut:
+      return Simd::select(t < 0.5f, 4.0f * t * t * t,
+                          1.0f - 4.0f * s * s * s);
+    case Ease::SineIn:
+      return 1.0f - sine(s * (PI * 0.5f));
+    case Ease::SineOut:
+      return sine(t * (PI * 0.5f));
+    case Ease::SineInOut:
+      // 0.5 - 0.5 * cos(pi * t)
+      return 0.5f - 0.5f * sine((0.5f - t) * PI);
+    case Ease::Smoothstep:
+      return t * t * (3.0f - 2.0f * t);
+    case Ease::Smootherstep:
+      return fade(t);
+  }
+  return t;
+}
+
+// the top 24 bits of the hash as a fraction
+template <typename U>
+static auto unit(U h) {
+  return Simd::toFloat(h >> 8) * (1.0f / 16777216);
+}
+
+// Calls f.template operator()<Float4>(i) for every four elements from i,
+// then f.template operator()<float>(i) for each remaining one.
+template <typename F>
+static void forLanes(size_t count, F&& f) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    f.template operator()<Float4>(i);
+  }
+  for (; i < count; i++) {
+    f.template operator()<float>(i);
+  }
+}
+
+template <size_t D, typename V>
+static void noiseSpan(std::span<const V> p, std::span<float> out,
+                      uint32_t seed) {
+  const float* in = reinterpret_cast<const float*>(p.data());
+  forLanes(std::min(p.size(), out.size()), [&]<typename T>(size_t i) {
+    T coords[D];
+    for (size_t k = 0; k < D; k++) {
+      coords[k] = Lanes<T>::gather(in + i * D + k, D);
+    }
+    Lanes<T>::scatter(&out[i], gradientNoise<D>(coords, seed));
+  });
+}
+
+float noise(float x, uint32_t seed) {
+  return gradientNoise<1>(&x, seed);
+}
+
+float noise(glm::vec2 p, uint32_t seed) {
+  float coords[2] = {p.x, p.y};
+  return gradientNoise<2>(coords, seed);
+}
+
+float noise(glm::vec3 p, uint32_t seed) {
+  float coords[3] = {p.x, p.y, p.z};
+  return gradientNoise<3>(coords, seed);
+}
+
+float noise(glm::vec4 p, uint32_t seed) {
+  float coords[4] = {p.x, p.y, p.z, p.w};
+  return gradientNoise<4>(coords, seed);
+}
+
+void noise(std::span<const float> x, std::span<float> out, uint32_t seed) {
+  noiseSpan<1>(x, out, seed);
+}
+
+void noise(std::span<const glm::vec2> p, std::span<float> out,
+           uint32_t seed) {
+  noiseSpan<2>(p, out, seed);
+}
+
+void noise(std::span<const glm::vec3> p, std::span<float> out,
+           uint32_t seed) {
+  noiseSpan<3>(p, out, seed);
+}
+
+void noise(std::span<const glm::vec4> p, std::span<float> out,
+           uint32_t seed) {
+  noiseSpan<4>(p, out, seed);
+}
+
+float ease(Ease curve, float t) {
+  return eased(curve, t);
+}
+
+void ease(Ease curve, std::span<const float> t, std::span<float> out) {
+  forLanes(std::min(t.size(), out.size()), [&]<typename T>(size_t i) {
+    Lanes<T>::scatter(&out[i], eased(curve, Lanes<T>::gather(&t[i], 1)));
+  });
+}
+
+float sin(float x) {
+  return sine(x);
+}
+
+void sin(std::span<const float> x, std::span<float> out) {
+  forLanes(std::min(x.size(), out.size()), [&]<typename T>(size_t i) {
+    Lanes<T>::scatter(&out[i], sine(Lanes<T>::gather(&x[i], 1)));
+  });
+}
+
+float random(uint32_t index, uint32_t seed) {
+  return unit(mix(index ^ mix(seed)));
+}
+
+float Random::next(float min, float max) {
+  return min + (max - min) * random(counter++, seed);
+}
+
+void Random::fill(std::span<float> out, float min, float max) {
+  const uint32_t key = mix(seed);
+  forLanes(out.size(), [&]<typename T>(size_t i) {
+    using U = typename Lanes<T>::Int;
+    U index = Lanes<T>::sequence(counter + static_cast<uint32_t>(i));
+    Lanes<T>::scatter(&out[i], min + (max - min) * unit(mix(index ^ U(key))));
+  });
+  counter += static_cast<uint32_t>(out.size());
+}
+
+const char* wgsl() {
+  return R"(
+    var<private> dusk_primes: array<u32, 4> =
+        array(0x9e3779b1u, 0x85ebca77u, 0xc2b2ae3du, 0x27d4eb2fu);
+    var<private> dusk_noise_scale: array<f32, 4> = array(2.15, 1.36, 1.15, 1.2);
+
+    fn dusk_mix(x: u32) -> u32 {
+        var h = x;
+        h = h ^ (h >> 16u);
+        h = h * 0x7feb352du;
+        h = h ^ (h >> 15u);
+        h = h * 0x846ca68bu;
+        return h ^ (h >> 16u);
+    }
+
+    fn dusk_fade(t: f32) -> f32 {
+        return t * t * t * (t * (t * 6.0 - 15.0) + 10.0);
+    }
+
+    // gradient noise over the first dims coordinates of p
+    fn dusk_noise(p: vec4f, dims: u32, seed: u32) -> f32 {
+        var f: array<f32, 4>;
+        var u: array<f32, 4>;
+        var cell: array<u32, 4>;
+        for (var k = 0u; k < dims; k++) {
+            let i = floor(p[k]);
+            f[k] = p[k] - i;
+            u[k] = dusk_fade(f[k]);
+            cell[k] = bitcast<u32>(i32(i)) * dusk_primes[k];
+        }
+
+        var values: array<f32, 16>;
+        for (var c = 0u; c < (1u << dims); c++) {
+            var h = seed;
+            for (var k = 0u; k < dims; k++) {
+                let far = ((c >> k) & 1u) == 1u;
+                h = h + select(cell[k], cell[k] + dusk_primes[k], far);
+            }
+            h = dusk_mix(h);
+            var d = 0.0;
+            for (var k = 0u; k < dims; k++) {
+                let far = ((c >> k) & 1u) == 1u;
+                let g = f32(i32((h >> (8u * k)) & 255u)) * (1.0 / 127.5) - 1.0;
+                d = d + g * select(f[k], f[k] - 1.0, far);
+            }
+            values[c] = d;
+        }
+
+        for (var k = i32(dims) - 1; k >= 0; k--) {
+            let stride = 1u << u32(k);
+            for (var c = 0u; c < stride; c++) {
+                values[c] = values[c] + (values[c + stride] - values[c]) * u[k];
+            }
+        }
+        return values[0] * dusk_noise_scale[dims - 1u];
+    }
+
+    fn dusk_noise1(x: f32, seed: u32) -> f32 {
+        return dusk_noise(vec4f(x, 0.0, 0.0, 0.0), 1u, seed);
+    }
+
+    fn dusk_noise2(p: vec2f, seed: u32) -> f32 {
+        return dusk_noise(vec4f(p, 0.0, 0.0), 2u, seed);
+    }
+
+    fn dusk_noise3(p: vec3f, seed: u32) -> f32 {
+        return dusk_noise(vec4f(p, 0.0), 3u, seed);
+    }
+
+    fn dusk_noise4(p: vec4f, seed: u32) -> f32 {
+        return dusk_noise(p, 4u, seed);
+    }
+
+    fn dusk_sin(x: f32) -> f32 {
+        let pi = 3.14159265358979;
+        let k = floor(x * (0.5 / pi) + 0.5);
+        var r = x - k * 6.28125 - k * 1.9353071795864769e-3;
+        r = select(select(r, -pi - r, r < pi * -0.5), pi - r, r > pi * 0.5);
+        let r2 = r * r;
+        return r * (1.0 + r2 * (-1.0 / 6.0 + r2 * (1.0 / 120.0 + r2 *
+            (-1.0 / 5040.0 + r2 * (1.0 / 362880.0 + r2 *
+            (-1.0 / 39916800.0))))));
+    }
+
+    // curve is the number of a Dusk::Batch::Ease
+    fn dusk_ease(curve: u32, x: f32) -> f32 {
+        let pi = 3.14159265358979;
+        let t = min(max(x, 0.0), 1.0);
+        let s = 1.0 - t;
+        switch curve {
+            case 1u: { return t * t; }
+            case 2u: { return 1.0 - s * s; }
+            case 3u: { return select(1.0 - 2.0 * s * s, 2.0 * t * t, t < 0.5); }
+            case 4u: { return t * t * t; }
+            case 5u: { return 1.0 - s * s * s; }
+            case 6u: {
+                return select(1.0 - 4.0 * s * s * s, 4.0 * t * t * t, t < 0.5);
+            }
+            case 7u: { return 1.0 - dusk_sin(s * (pi * 0.5)); }
+            case 8u: { return dusk_sin(t * (pi * 0.5)); }
+            case 9u: { return 0.5 - 0.5 * dusk_sin((0.5 - t) * pi); }
+            case 10u: { return t * t * (3.0 - 2.0 * t); }
+            case 11u: { return dusk_fade(t); }
+            default: { return t; }
+        }
+    }
+
+    fn dusk_random(index: u32, seed: u32) -> f32 {
+        return f32(i32(dusk_mix(index ^ dusk_mix(seed)) >> 8u)) *
+            (1.0 / 16777216.0);
+    }
+)";
+}
+
+}  // namespace Dusk::Batch
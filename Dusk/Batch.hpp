@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <span>
+
+// Math for animating many elements at once. The span versions work four
+// elements at a time in SIMD registers and write min(input, output size)
+// results. Every function gives exactly the same results as its single
+// element version and, up to the GPU's float rounding, as its counterpart
+// in wgsl().
+namespace Dusk::Batch {
+
+// Gradient (Perlin) noise, roughly within [-1, 1] and zero on every integer
+// point. Different seeds give unrelated fields. Coordinates must stay below
+// 2^31 in magnitude.
+float noise(float x, uint32_t seed = 0);
+float noise(glm::vec2 p, uint32_t seed = 0);
+float noise(glm::vec3 p, uint32_t seed = 0);
+float noise(glm::vec4 p, uint32_t seed = 0);
+void noise(std::span<const float> x, std::span<float> out, uint32_t seed = 0);
+void noise(std::span<const glm::vec2> p, std::span<float> out,
+           uint32_t seed = 0);
+void noise(std::span<const glm::vec3> p, std::span<float> out,
+           uint32_t seed = 0);
+void noise(std::span<const glm::vec4> p, std::span<float> out,
+           uint32_t seed = 0);
+
+// The number of a curve is its argument to dusk_ease() in WGSL.
+enum class Ease : uint32_t {
+  Linear,
+  QuadIn,
+  QuadOut,
+  QuadInOut,
+  CubicIn,
+  CubicOut,
+  CubicInOut,
+  SineIn,
+  SineOut,
+  SineInOut,
+  Smoothstep,
+  Smootherstep,
+};
+
+// Eases t, which is clamped to [0, 1].
+float ease(Ease curve, float t);
+void ease(Ease curve, std::span<const float> t, std::span<float> out);
+
+// sin() within 3e-7 for arguments up to a few thousand radians.
+float sin(float x);
+void sin(std::span<const float> x, std::span<float> out);
+
+// Uniform numbers in [0, 1) from a counter-based generator. Number i of a
+// seed depends on nothing but i and the seed, so any part of the sequence
+// can be drawn on its own, on several threads or on the GPU.
+float random(uint32_t index, uint32_t seed = 0);
+
+// Draws consecutive numbers of random()'s sequence for a seed.
+class Random {
+ public:
+  explicit Random(uint32_t seed = 0) : seed(seed) {}
+
+  // between min and max
+  float next(float min = 0, float max = 1);
+  void fill(std::span<float> out, float min = 0, float max = 1);
+
+  // index of the next number in the sequence
+  inline uint32_t getCounter() {
+    return counter;
+  }
+
+  inline void setCounter(uint32_t counter) {
+    this->counter = counter;
+  }
+
+ private:
+  uint32_t seed;
+  uint32_t counter = 0;
+};
+
+// WGSL source of dusk_noise1() to dusk_noise4(), dusk_ease(), dusk_sin()
+// and dusk_random(), to be put in front of a shader that calls them.
+const char* wgsl();
+
+}  // namespace Dusk::Batch
@@ -0,0 +1,211 @@
+#include <Dusk/Builder/BindGroup.hpp>
+#include <Dusk/BufferGeometry.hpp>
+#include <Dusk/Shader.hpp>
+#include <string>
+#include <vector>
+
+namespace Dusk {
+
+static uint64_t formatSize(wgpu::VertexFormat format) {
+  switch (format) {
+    case wgpu::VertexFormat::Unorm8x4:
+    case wgpu::VertexFormat::Float32:
+    case wgpu::VertexFormat::Uint32:
+      return 4;
+    case wgpu::VertexFormat::Float32x2:
+      return 8;
+    case wgpu::VertexFormat::Float32x3:
+      return 12;
+    case wgpu::VertexFormat::Float32x4:
+      return 16;
+    default:
+      return 0;
+  }
+}
+
+BufferGeometry& BufferGeometry::vertices(wgpu::Buffer buffer, uint32_t count,
+                                         wgpu::VertexFormat format,
+                                         uint64_t stride, uint64_t offset) {
+  dirty |= format != positionSource.format;
+  positionSource = {buffer, format, stride ? stride : formatSize(format),
+                    offset};
+  vertexCount = count;
+  return *this;
+}
+
+BufferGeometry& BufferGeometry::colors(wgpu::Buffer buffer,
+                                       wgpu::VertexFormat format,
+                                       uint64_t stride, uint64_t offset) {
+  dirty |= format != colorSource.format;
+  colorSource = {buffer, format, stride ? stride : formatSize(format), offset};
+  return *this;
+}
+
+BufferGeometry& BufferGeometry::instances(wgpu::Buffer buffer, uint32_t count,
+                                          wgpu::VertexFormat format,
+                                          uint64_t stride, uint64_t offset) {
+  dirty |= format != instanceSource.format;
+  instanceSource = {buffer, format, stride ? stride : formatSize(format),
+                    offset};
+  instanceCount = count;
+  return *this;
+}
+
+BufferGeometry& BufferGeometry::color(glm::vec4 color) {
+  tint = color;
+  return *this;
+}
+
+BufferGeometry& BufferGeometry::topology(wgpu::PrimitiveTopology topology) {
+  dirty |= topology != m_topology;
+  m_topology = topology;
+  return *this;
+}
+
+void BufferGeometry::prepare(const RenderContext& context) {
+  if (!ctx.compatible(context)) {
+    ctx = context;
+    dirty = true;
+  }
+  // the vertex layout needs the format vertices() gives
+  if (vertexCount == 0) {
+    return;
+  }
+  if (dirty) {
+    createPipeline();
+    dirty = false;
+  }
+  ctx.device.GetQueue().WriteBuffer(tintBuffer, 0, &tint, sizeof(glm::vec4));
+}
+
+void BufferGeometry::render(wgpu::RenderPassEncoder& pass) {
+  if (vertexCount == 0) {
+    return;
+  }
+  pass.SetPipeline(pipeline);
+  pass.SetBindGroup(0, bindGroup);
+  uint32_t slot = 0;
+  for (Source* s : {&positionSource, &colorSource, &instanceSource}) {
+    if (s->buffer) {
+      pass.SetVertexBuffer(slot++, s->buffer, s->offset,
+                           s->buffer.GetSize() - s->offset);
+    }
+  }
+  pass.Draw(vertexCount, instanceSource.buffer ? instanceCount : 1);
+}
+
+void BufferGeometry::createPipeline() {
+  wgpu::Device& device = ctx.device;
+  const bool hasColors = static_cast<bool>(colorSource.buffer);
+  const bool hasInstances = static_cast<bool>(instanceSource.buffer);
+
+  // inputs are declared as vec4f, missing components read as (0, 0, 0, 1)
+  std::string inputs = "@location(0) pos: vec4f,";
+  std::string body = "var pos = in.pos.xyz;\n";
+  body += "out.col = tint;\n";
+  if (hasColors) {
+    inputs += "@location(1) col: vec4f,";
+    body += "out.col *= in.col;\n";
+  }
+  if (hasInstances) {
+    inputs += "@location(2) offset: vec4f,";
+    body += "pos += vec3f(in.offset.xy, 0.0);\n";
+  }
+
+  std::string source = R"(
+    @group(0) @binding(0) var<uniform> transformMat: mat4x4f;
+    @group(0) @binding(1) var<uniform> tint: vec4f;
+
+    struct VertexInput {
+        )" + inputs + R"(
+    };
+
+    struct VertexOutput {
+        @builtin(position) pos: vec4f,
+        @location(0) col: vec4f
+    };
+
+    @vertex
+    fn vs_main(in: VertexInput) -> VertexOutput {
+        var out: VertexOutput;
+        )" + body + R"(
+        out.pos = transformMat * vec4f(pos, 1.0);
+        return out;
+    }
+
+    @fragment
+    fn fs_main(in: VertexOutput) -> @location(0) vec4f {
+        return in.col;
+    })";
+  Dusk::Shader shader =
+      Dusk::ShaderBuilder().source(source.c_str()).build(device);
+
+  std::vector<wgpu::VertexAttribute> attributes(3);
+  std::vector<wgpu::VertexBufferLayout> layouts;
+  auto addLayout = [&](const Source& s, uint32_t location,
+                       wgpu::VertexStepMode stepMode) {
+    wgpu::VertexAttribute& attribute = attributes[location];
+    attribute.shaderLocation = location;
+    attribute.format = s.format;
+    attribute.offset = 0;
+
+    wgpu::VertexBufferLayout layout;
+    layout.attributeCount = 1;
+    layout.attributes = &attribute;
+    layout.stepMode = stepMode;
+    layout.arrayStride = s.stride;
+    layouts.push_back(layout);
+  };
+
+  addLayout(positionSource, 0, wgpu::VertexStepMode::Vertex);
+  if (hasColors) {
+    addLayout(colorSource, 1,
+              hasInstances ? wgpu::VertexStepMode::Instance
+                           : wgpu::VertexStepMode::Vertex);
+  }
+  if (hasInstances) {
+    addLayout(instanceSource, 2, wgpu::VertexStepMode::Instance);
+  }
+
+  wgpu::BlendState blend;
+  blend.color.srcFactor = wgpu::BlendFactor::SrcAlpha;
+  blend.color.dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha;
+  blend.color.operation = wgpu::BlendOperation::Add;
+  blend.alpha.srcFactor = wgpu::BlendFactor::One;
+  blend.alpha.dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha;
+  blend.alpha.operation = wgpu::BlendOperation::Add;
+
+  wgpu::ColorTargetState colTarget;
+  colTarget.format = ctx.format;
+  colTarget.blend = &blend;
+  wgpu::FragmentState frag;
+  frag.module = shader.mod;
+  frag.entryPoint = "fs_main";
+  frag.targetCount = 1;
+  frag.targets = &colTarget;
+
+  wgpu::RenderPipelineDescriptor pipelineDesc;
+  pipelineDesc.vertex.module = shader.mod;
+  pipelineDesc.vertex.entryPoint = "vs_main";
+  pipelineDesc.vertex.bufferCount = layouts.size();
+  pipelineDesc.vertex.buffers = layouts.data();
+  pipelineDesc.primitive.topology = m_topology;
+  pipelineDesc.fragment = &frag;
+  pipelineDesc.multisample.count = ctx.sampleCount;
+  pipelineDesc.multisample.mask = ~0u;
+  pipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+  if (!tintBuffer) {
+    wgpu::BufferDescriptor desc{};
+    desc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+    desc.size = sizeof(glm::vec4);
+    tintBuffer = device.CreateBuffer(&desc);
+  }
+  bindGroup = Builder::BindGroup()
+                  .layout(pipeline.GetBindGroupLayout(0))
+                  .buffer(0, ctx.transformBuffer, 0, sizeof(float) * 16)
+                  .buffer(1, tintBuffer, 0, sizeof(glm::vec4))
+                  .build(device);
+}
+
+}  // namespace Dusk
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/Renderable.hpp>
+#include <cstdint>
+#include <glm/vec4.hpp>
+
+namespace Dusk {
+
+// Draws vertex data that already lives on the GPU, e.g. the output of a
+// compute pass. Positions come from vertices(); with instances() the
+// vertices form one shape that is drawn at every instance position, and
+// colors() are then read per instance. A stride of 0 means tightly packed.
+class BufferGeometry : public Renderable {
+ public:
+  BufferGeometry& vertices(
+      wgpu::Buffer buffer, uint32_t count,
+      wgpu::VertexFormat format = wgpu::VertexFormat::Float32x2,
+      uint64_t stride = 0, uint64_t offset = 0);
+
+  BufferGeometry& colors(
+      wgpu::Buffer buffer,
+      wgpu::VertexFormat format = wgpu::VertexFormat::Float32x4,
+      uint64_t stride = 0, uint64_t offset = 0);
+
+  BufferGeometry& instances(
+      wgpu::Buffer buffer, uint32_t count,
+      wgpu::VertexFormat format = wgpu::VertexFormat::Float32x2,
+      uint64_t stride = 0, uint64_t offset = 0);
+
+  // multiplied with the colors, or used as is without them
+  BufferGeometry& color(glm::vec4 color);
+  BufferGeometry& topology(wgpu::PrimitiveTopology topology);
+
+  void prepare(const RenderContext& context) override;
+  void render(wgpu::RenderPassEncoder& pass) override;
+
+ private:
+  struct Source {
+    wgpu::Buffer buffer;
+    wgpu::VertexFormat format = wgpu::VertexFormat::Undefined;
+    uint64_t stride = 0;
+    uint64_t offset = 0;
+  };
+
+  void createPipeline();
+
+  Source positionSource;
+  Source colorSource;
+  Source instanceSource;
+  uint32_t vertexCount = 0;
+  uint32_t instanceCount = 0;
+  glm::vec4 tint{1, 1, 1, 1};
+  wgpu::PrimitiveTopology m_topology = wgpu::PrimitiveTopology::TriangleList;
+
+  bool dirty = true;
+  RenderContext ctx{};
+  wgpu::RenderPipeline pipeline;
+  wgpu::Buffer tintBuffer;
+  wgpu::BindGroup bindGroup;
+};
+
+}  // namespace Dusk
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace Dusk {
+namespace Builder {
+
+class BindGroup {
+ public:
+  BindGroup& layout(wgpu::BindGroupLayout layout) {
+    m_layout = layout;
+    return *this;
+  }
+
+  BindGroup& buffer(uint32_t binding, wgpu::Buffer buffer,
+                    uint64_t offset = 0, uint64_t size = WGPU_WHOLE_SIZE) {
+    wgpu::BindGroupEntry entry{};
+    entry.binding = binding;
+    entry.buffer = buffer;
+    entry.offset = offset;
+    entry.size = size;
+    entries.push_back(entry);
+    return *this;
+  }
+
+  BindGroup& texture(uint32_t binding, wgpu::TextureView view) {
+    wgpu::BindGroupEntry entry{};
+    entry.binding = binding;
+    entry.textureView = view;
+    entries.push_back(entry);
+    return *this;
+  }
+
+  BindGroup& sampler(uint32_t binding, wgpu::Sampler sampler) {
+    wgpu::BindGroupEntry entry{};
+    entry.binding = binding;
+    entry.sampler = sampler;
+    entries.push_back(entry);
+    return *this;
+  }
+
+  BindGroup& label(const char* label) {
+    desc.label = label;
+    return *this;
+  }
+
+  wgpu::BindGroup build(const wgpu::Device& device) {
+    desc.layout = m_layout;
+    desc.entryCount = entries.size();
+    desc.entries = entries.data();
+    return device.CreateBindGroup(&desc);
+  }
+
+ private:
+  wgpu::BindGroupDescriptor desc{};
+  wgpu::BindGroupLayout m_layout;
+  std::vector<wgpu::BindGroupEntry> entries;
+};
+
+}  // namespace Builder
+}  // namespace Dusk
@@ -2,13 +2,18 @@
 
 #include <webgpu/webgpu_cpp.h>
 
+#include <Dusk/Log.hpp>
+#include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <glm/mat4x4.hpp>
-#include <vector>
+#include <span>
 
 namespace Dusk {
 namespace Builder {
 
+// Buffers with initial contents are created mapped and written straight
+// into the mapping, so the data is copied once on the way to the GPU.
 template <typename T, wgpu::BufferUsage U>
 class Buffer {
  public:
@@ -16,19 +21,42 @@ class Buffer {
     desc.usage = U;
   }
 
-  Buffer<T, U>& data(std::vector<T> data) {
+  // The data is not copied until build(), keep it alive until then.
+  Buffer<T, U>& data(std::span<const T> data) {
     m_data = data;
-    desc.size = data.size() * sizeof(T);
+    m_fill = nullptr;
+    m_count = data.size();
+    desc.size = data.size_bytes();
+    return *this;
+  }
+
+  // Allocates room for count elements without uploading anything. WebGPU
+  // zero-initializes the buffer.
+  Buffer<T, U>& size(uint64_t count) {
+    m_data = {};
+    m_fill = nullptr;
+    m_count = 0;
+    desc.size = count * sizeof(T);
     return *this;
   }
 
   Buffer<T, U>& data(glm::mat4 data) {
-    for (int i = 0; i < 4; i++) {
-      for (int j = 0; j < 4; j++) {
-        m_data.push_back(data[i][j]);
+    return fill(16, [data](std::span<T> out) {
+      for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+          out[i * 4 + j] = data[i][j];
+        }
       }
-    }
-    desc.size = 16 * sizeof(T);
+    });
+  }
+
+  // Lets fill write count elements right into the mapped buffer, for
+  // contents that are generated rather than already in memory.
+  Buffer<T, U>& fill(uint64_t count, std::function<void(std::span<T>)> fill) {
+    m_data = {};
+    m_fill = std::move(fill);
+    m_count = count;
+    desc.size = count * sizeof(T);
     return *this;
   }
 
@@ -42,11 +70,15 @@ class Buffer {
     return *this;
   }
 
+  // Leaves a buffer without contents mapped for the caller to write and
+  // unmap. Buffers with data or a fill are always mapped while building.
   Buffer<T, U>& mappedAtCreation(bool mappedAtCreation) {
     desc.mappedAtCreation = mappedAtCreation;
     return *this;
   }
 
+  // Byte offset of the contents in the buffer, a multiple of 8. The buffer
+  // is enlarged to hold them.
   Buffer<T, U>& offset(uint64_t offset) {
     m_offset = offset;
     return *this;
@@ -58,17 +90,44 @@ class Buffer {
   }
 
   wgpu::Buffer build(const wgpu::Device device) {
-    wgpu::Queue queue = device.GetQueue();
-    wgpu::Buffer buf = device.CreateBuffer(&desc);
-    queue.WriteBuffer(buf, m_offset, m_data.data(), desc.size);
+    const bool upload = !m_data.empty() || m_fill;
+    if (!upload) {
+      return device.CreateBuffer(&desc);
+    }
+
+    const uint64_t bytes = m_count * sizeof(T);
+    wgpu::BufferDescriptor mappedDesc = desc;
+    mappedDesc.mappedAtCreation = true;
+    // mapped sizes have to be a multiple of 4
+    mappedDesc.size = (m_offset + bytes + 3) & ~uint64_t{3};
+    wgpu::Buffer buf = device.CreateBuffer(&mappedDesc);
+
+    void* mapped = buf.GetMappedRange(m_offset, (bytes + 3) & ~uint64_t{3});
+    if (!mapped) {
+      DUSK_LOG(LogLevel::Error, "Dawn::WebGPU",
+               "Unable to map buffer for writing");
+      return buf;
+    }
+    std::span<T> out(static_cast<T*>(mapped), m_count);
+    if (m_fill) {
+      m_fill(out);
+    } else {
+      std::copy(m_data.begin(), m_data.end(), out.begin());
+    }
+    buf.Unmap();
     return buf;
   }
 
  private:
   wgpu::BufferDescriptor desc;
-  std::vector<T> m_data;
+  std::span<const T> m_data;
+  std::function<void(std::span<T>)> m_fill;
+  uint64_t m_count = 0;
   uint64_t m_offset = 0;
 };
 
+template <typename T>
+using StorageBuffer = Buffer<T, wgpu::BufferUsage::Storage>;
+
 }  // namespace Builder
-}  // namespace Dusk
\ No newline at end of file
+}  // namespace Dusk
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/Shader.hpp>
+
+namespace Dusk {
+namespace Builder {
+
+// Builds a compute pipeline with an automatic layout unless one is given, so
+// bind group layouts can be queried with GetBindGroupLayout().
+class ComputePipeline {
+ public:
+  ComputePipeline& shader(const Shader& shader) {
+    desc.compute.module = shader.mod;
+    return *this;
+  }
+
+  ComputePipeline& entryPoint(const char* entryPoint) {
+    desc.compute.entryPoint = entryPoint;
+    return *this;
+  }
+
+  // for pipelines sharing bind groups, which automatic layouts cannot
+  ComputePipeline& layout(const wgpu::PipelineLayout& layout) {
+    desc.layout = layout;
+    return *this;
+  }
+
+  ComputePipeline& label(const char* label) {
+    desc.label = label;
+    return *this;
+  }
+
+  wgpu::ComputePipeline build(const wgpu::Device& device) {
+    return device.CreateComputePipeline(&desc);
+  }
+
+ private:
+  wgpu::ComputePipelineDescriptor desc{};
+};
+
+}  // namespace Builder
+}  // namespace Dusk
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/Drawables.hpp>
+#include <Dusk/Layer.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include <vector>
+
+namespace Dusk {
+
+// A rectangle of pixels, x1 and y1 exclusive.
+struct Region {
+  uint32_t x0 = 0;
+  uint32_t y0 = 0;
+  uint32_t x1 = 0;
+  uint32_t y1 = 0;
+
+  inline bool empty() const {
+    return x1 <= x0 || y1 <= y0;
+  }
+
+  inline uint32_t width() const {
+    return empty() ? 0 : x1 - x0;
+  }
+
+  inline uint32_t height() const {
+    return empty() ? 0 : y1 - y0;
+  }
+};
+
+// Accumulates everything a drawer draws while it is set with
+// Drawer::setCanvas() in a texture of its own, which is shown on every
+// frame. Only the pixels covered by the shapes queued since the last frame
+// are rasterized, so a frame adding nothing costs a single blit.
+//
+// The contents survive Drawer::resize(). The canvas also keeps a journal of
+// the built-in shapes drawn since the last clear and replays it when it
+// finds itself on a different device, e.g. a drawer recreated after device
+// loss. Composites, renderables and custom shapes are drawn but not
+// journaled. The journal holds at most getJournalLimit() shapes: past that
+// it is dropped with a warning until the next clear, and a canvas on a new
+// device starts out cleared.
+class Canvas {
+ public:
+  static constexpr size_t DEFAULT_JOURNAL_LIMIT = 100000;
+
+  // 0 turns journaling off
+  inline void setJournalLimit(size_t limit) {
+    journalLimit = limit;
+  }
+
+  inline size_t getJournalLimit() {
+    return journalLimit;
+  }
+
+  // false once the journal was dropped, until the next clear
+  inline bool isJournaled() {
+    return journalLimit > 0 && !journalDropped;
+  }
+
+  // built-in shapes that would be replayed
+  inline size_t getJournalSize() {
+    return journal.size();
+  }
+
+  // the pixels the last frame rasterized into the canvas
+  inline const Region& getDamage() {
+    return damage;
+  }
+
+  inline const Layer& getLayer() {
+    return layer;
+  }
+
+ private:
+  friend class Drawer;
+
+  struct Entry {
+    Drawable::Shape shape;
+    // index into models
+    uint32_t model;
+  };
+
+  Layer layer;
+  // the device the layer's textures belong to
+  wgpu::Device device;
+  std::vector<Entry> journal;
+  std::vector<glm::mat4> models;
+  size_t journalLimit = DEFAULT_JOURNAL_LIMIT;
+  bool journalDropped = false;
+  // what the journal is drawn over
+  glm::vec4 clearColor{0};
+  Region damage;
+};
+
+}  // namespace Dusk
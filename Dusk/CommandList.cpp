@@ -0,0 +1,9 @@
+#include <Dusk/CommandList.hpp>
+
+namespace Dusk {
+
+void CommandList::clear() {
+  clearQueue();
+}
+
+}  // namespace Dusk
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Dusk/ShapeQueue.hpp>
+#include <cstdint>
+
+namespace Dusk {
+
+// Shapes queued from one thread, see Drawer::commandList(). A list only
+// touches its own arena, so several threads can fill their own lists at
+// the same time without locking. The drawer reads every list when it draws,
+// which must not overlap with anyone still writing to one. The matrix stack
+// of a list is its own, matrices of the drawer do not apply.
+class CommandList : public ShapeQueue {
+ public:
+  CommandList() = default;
+  CommandList(const CommandList&) = delete;
+  CommandList& operator=(const CommandList&) = delete;
+
+  // Forgets the queued shapes, which the drawer does after drawing them.
+  void clear();
+
+ private:
+  friend class Drawer;
+
+  // where the list's shapes start in the drawer's queue once merged
+  uint32_t base = 0;
+};
+
+}  // namespace Dusk
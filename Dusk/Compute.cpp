@@ -0,0 +1,51 @@
+#include <Dusk/Builder/ComputePipeline.hpp>
+#include <Dusk/Compute.hpp>
+#include <Dusk/Shader.hpp>
+
+namespace Dusk {
+
+Compute::Compute(wgpu::Device& device) : device(device) {}
+
+wgpu::ComputePipeline Compute::pipeline(const char* source,
+                                        const char* entryPoint) {
+  Dusk::Shader shader = Dusk::ShaderBuilder().source(source).build(device);
+  return Builder::ComputePipeline()
+      .shader(shader)
+      .entryPoint(entryPoint)
+      .build(device);
+}
+
+Compute& Compute::dispatch(const wgpu::ComputePipeline& pipeline,
+                           const wgpu::BindGroup& bindGroup, uint32_t x,
+                           uint32_t y, uint32_t z) {
+  pending.push_back({pipeline, bindGroup, x, y, z});
+  return *this;
+}
+
+void Compute::submit() {
+  if (pending.empty()) {
+    return;
+  }
+  wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+  encode(encoder);
+  wgpu::CommandBuffer commands = encoder.Finish();
+  device.GetQueue().Submit(1, &commands);
+}
+
+void Compute::encode(wgpu::CommandEncoder& encoder) {
+  if (pending.empty()) {
+    return;
+  }
+  // every dispatch is its own usage scope, so later dispatches see the
+  // writes of earlier ones within the same pass
+  wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+  for (auto& d : pending) {
+    pass.SetPipeline(d.pipeline);
+    pass.SetBindGroup(0, d.bindGroup);
+    pass.DispatchWorkgroups(d.x, d.y, d.z);
+  }
+  pass.End();
+  pending.clear();
+}
+
+}  // namespace Dusk
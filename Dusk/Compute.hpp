@@ -0,0 +1,49 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/Renderable.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Dusk {
+
+// Records compute dispatches for GPU simulations. Pending dispatches either
+// run on their own with submit(), or get recorded into the drawer's frame
+// ahead of its render pass by queueing this with Drawer::add().
+class Compute : public Renderable {
+ public:
+  Compute() = default;
+  Compute(wgpu::Device& device);
+
+  wgpu::ComputePipeline pipeline(const char* source,
+                                 const char* entryPoint = "main");
+
+  Compute& dispatch(const wgpu::ComputePipeline& pipeline,
+                    const wgpu::BindGroup& bindGroup, uint32_t x,
+                    uint32_t y = 1, uint32_t z = 1);
+
+  void submit();
+
+  inline bool hasPending() {
+    return !pending.empty();
+  }
+
+  void prepare([[maybe_unused]] const RenderContext& context) override {};
+  void encode(wgpu::CommandEncoder& encoder) override;
+  void render([[maybe_unused]] wgpu::RenderPassEncoder& pass) override {};
+
+ private:
+  struct Dispatch {
+    wgpu::ComputePipeline pipeline;
+    wgpu::BindGroup bindGroup;
+    uint32_t x;
+    uint32_t y;
+    uint32_t z;
+  };
+
+  wgpu::Device device;
+  std::vector<Dispatch> pending;
+};
+
+}  // namespace Dusk
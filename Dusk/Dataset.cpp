@@ -0,0 +1,130 @@
+#include <Dusk/Dataset.hpp>
+#include <Dusk/Dots.hpp>
+#include <Dusk/Log.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <format>
+
+namespace Dusk {
+
+// every column holds 4 bytes per point
+static constexpr uint64_t COLUMN_STRIDE = 4;
+
+Dataset::Dataset(const std::string& path)
+    : file(std::make_shared<MappedFile>(path)) {
+  if (!*file) {
+    return;
+  }
+  Header header{};
+  if (file->size() >= sizeof(Header)) {
+    std::memcpy(&header, file->data(), sizeof(Header));
+  }
+  if (header.magic != MAGIC || header.version != VERSION ||
+      header.count > (file->size() - sizeof(Header)) /
+                         (COLUMNS * COLUMN_STRIDE)) {
+    DUSK_LOG(LogLevel::Error, "Dusk",
+             std::format("{} is not a supported dataset", path));
+    file.reset();
+    return;
+  }
+  count = header.count;
+  for (size_t i = 0; i < COLUMNS; i++) {
+    file->prefetch(column(i) - file->data(), chunk * COLUMN_STRIDE);
+  }
+}
+
+bool Dataset::write(const std::string& path, std::span<const float> x,
+                    std::span<const float> y, std::span<const float> sizes,
+                    std::span<const uint32_t> colors) {
+  if (y.size() != x.size() || sizes.size() != x.size() ||
+      colors.size() != x.size()) {
+    DUSK_LOG(LogLevel::Error, "Dusk", "Dataset columns differ in length");
+    return false;
+  }
+  FILE* out = std::fopen(path.c_str(), "wb");
+  if (!out) {
+    DUSK_LOG(LogLevel::Error, "Dusk", std::format("Unable to open {}", path));
+    return false;
+  }
+  Header header{MAGIC, VERSION, x.size()};
+  bool ok = std::fwrite(&header, sizeof(Header), 1, out) == 1 &&
+            std::fwrite(x.data(), sizeof(float), x.size(), out) == x.size() &&
+            std::fwrite(y.data(), sizeof(float), y.size(), out) == y.size() &&
+            std::fwrite(sizes.data(), sizeof(float), sizes.size(), out) ==
+                sizes.size() &&
+            std::fwrite(colors.data(), sizeof(uint32_t), colors.size(),
+                        out) == colors.size();
+  ok = std::fclose(out) == 0 && ok;
+  if (!ok) {
+    DUSK_LOG(LogLevel::Error, "Dusk", std::format("Unable to write {}", path));
+  }
+  return ok;
+}
+
+Dataset& Dataset::chunkSize(uint64_t points) {
+  chunk = std::max<uint64_t>(points, 1);
+  return *this;
+}
+
+const uint8_t* Dataset::column(size_t i) {
+  return file->data() + sizeof(Header) + i * count * COLUMN_STRIDE;
+}
+
+void Dataset::createBuffers() {
+  wgpu::BufferDescriptor desc{};
+  desc.usage = wgpu::BufferUsage::Vertex | wgpu::BufferUsage::CopyDst;
+  desc.size = count * COLUMN_STRIDE;
+  for (wgpu::Buffer& buffer : columns) {
+    buffer = ctx.device.CreateBuffer(&desc);
+  }
+  loaded = 0;
+}
+
+void Dataset::prepare(const RenderContext& context) {
+  if (count == 0) {
+    return;
+  }
+  if (!pipeline || !ctx.compatible(context)) {
+    bool newDevice = ctx.device.Get() != context.device.Get();
+    ctx = context;
+    pipeline = createDotPipeline(ctx, {});
+    bindGroup = createDotBindGroup(ctx, pipeline);
+    if (newDevice) {
+      createBuffers();
+    }
+  }
+  if (loaded == count) {
+    return;
+  }
+
+  // WriteBuffer copies out of the mapping into its staging memory, so the
+  // columns are never copied on the CPU side
+  uint64_t n = std::min(chunk, count - loaded);
+  wgpu::Queue queue = ctx.device.GetQueue();
+  for (size_t i = 0; i < COLUMNS; i++) {
+    queue.WriteBuffer(columns[i], loaded * COLUMN_STRIDE,
+                      column(i) + loaded * COLUMN_STRIDE, n * COLUMN_STRIDE);
+  }
+  loaded += n;
+
+  // have the kernel read the next chunk while this frame renders
+  for (size_t i = 0; i < COLUMNS && loaded < count; i++) {
+    file->prefetch(column(i) - file->data() + loaded * COLUMN_STRIDE,
+                   chunk * COLUMN_STRIDE);
+  }
+}
+
+void Dataset::render(wgpu::RenderPassEncoder& pass) {
+  if (loaded == 0) {
+    return;
+  }
+  pass.SetPipeline(pipeline);
+  pass.SetBindGroup(0, bindGroup);
+  for (uint32_t i = 0; i < COLUMNS; i++) {
+    pass.SetVertexBuffer(i, columns[i]);
+  }
+  pass.Draw(4, static_cast<uint32_t>(loaded));
+}
+
+}  // namespace Dusk
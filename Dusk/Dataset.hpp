@@ -0,0 +1,76 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/MappedFile.hpp>
+#include <Dusk/Renderable.hpp>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace Dusk {
+
+// Points stored column by column in a binary file: a 16 byte header (magic
+// "DSKD", version and point count) followed by the x, y and size (f32) and
+// color (RGBA8) columns. The file is memory mapped and uploaded to the GPU
+// straight from the mapping, a chunk per frame, so the first points are
+// drawn long before the whole file has been read.
+class Dataset : public Renderable {
+ public:
+  Dataset() = default;
+  explicit Dataset(const std::string& path);
+
+  static bool write(const std::string& path, std::span<const float> x,
+                    std::span<const float> y, std::span<const float> sizes,
+                    std::span<const uint32_t> colors);
+
+  // Points uploaded per frame until the whole file is on the GPU.
+  Dataset& chunkSize(uint64_t points);
+
+  inline uint64_t getCount() {
+    return count;
+  }
+
+  inline uint64_t getLoaded() {
+    return loaded;
+  }
+
+  inline bool isLoaded() {
+    return loaded == count;
+  }
+
+  inline explicit operator bool() const {
+    return count > 0;
+  }
+
+  void prepare(const RenderContext& context) override;
+  void render(wgpu::RenderPassEncoder& pass) override;
+
+ private:
+  struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t count;
+  };
+
+  static constexpr uint32_t MAGIC = 0x444b5344;  // "DSKD"
+  static constexpr uint32_t VERSION = 1;
+  static constexpr size_t COLUMNS = 4;
+
+  const uint8_t* column(size_t i);
+  void createBuffers();
+
+  // shared so copies of a dataset keep the mapping alive
+  std::shared_ptr<MappedFile> file;
+  uint64_t count = 0;
+  uint64_t loaded = 0;
+  uint64_t chunk = 1 << 18;
+
+  RenderContext ctx{};
+  wgpu::RenderPipeline pipeline;
+  wgpu::BindGroup bindGroup;
+  wgpu::Buffer columns[COLUMNS];
+};
+
+}  // namespace Dusk
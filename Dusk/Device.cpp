@@ -0,0 +1,57 @@
+#include <Dusk/Device.hpp>
+#include <Dusk/Log.hpp>
+#include <cstdint>
+#include <format>
+
+namespace Dusk {
+
+wgpu::Device requestDevice(wgpu::Instance& instance) {
+  wgpu::Adapter adapter;
+  wgpu::RequestAdapterOptions adapterOpts{};
+  wgpu::RequestAdapterCallbackInfo adapterCallback{};
+  adapterCallback.mode = wgpu::CallbackMode::WaitAnyOnly;
+  adapterCallback.userdata = &adapter;
+  adapterCallback.callback = [](WGPURequestAdapterStatus status,
+                                WGPUAdapter adapter, const char* message,
+                                void* userdata) {
+    if (status != WGPURequestAdapterStatus_Success) {
+      DUSK_LOG(LogLevel::Error, "Dawn::WebGPU",
+               std::format("Unable to get adapter: {}", message));
+      return;
+    }
+    *static_cast<wgpu::Adapter*>(userdata) = wgpu::Adapter::Acquire(adapter);
+  };
+  instance.WaitAny(instance.RequestAdapter(&adapterOpts, adapterCallback),
+                   UINT64_MAX);
+  if (!adapter) {
+    return nullptr;
+  }
+
+  wgpu::DeviceDescriptor deviceDesc{};
+  // lets dynamic resolution measure the GPU's own frame time
+  const wgpu::FeatureName timestamps = wgpu::FeatureName::TimestampQuery;
+  if (adapter.HasFeature(timestamps)) {
+    deviceDesc.requiredFeatureCount = 1;
+    deviceDesc.requiredFeatures = &timestamps;
+  }
+
+  wgpu::Device device;
+  wgpu::RequestDeviceCallbackInfo deviceCallback{};
+  deviceCallback.mode = wgpu::CallbackMode::WaitAnyOnly;
+  deviceCallback.userdata = &device;
+  deviceCallback.callback = [](WGPURequestDeviceStatus status,
+                               WGPUDevice device, const char* message,
+                               void* userdata) {
+    if (status != WGPURequestDeviceStatus_Success) {
+      DUSK_LOG(LogLevel::Error, "Dawn::WebGPU",
+               std::format("Unable to get device: {}", message));
+      return;
+    }
+    *static_cast<wgpu::Device*>(userdata) = wgpu::Device::Acquire(device);
+  };
+  instance.WaitAny(adapter.RequestDevice(&deviceDesc, deviceCallback),
+                   UINT64_MAX);
+  return device;
+}
+
+}  // namespace Dusk
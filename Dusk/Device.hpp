@@ -0,0 +1,13 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+namespace Dusk {
+
+// Adapter and device for drawing without a window, waiting on the instance
+// until both arrive. The instance needs timedWaitAnyEnable. TimestampQuery
+// is requested when the adapter has it. Returns a null device, after logging
+// why, when there is no adapter or the device request fails.
+wgpu::Device requestDevice(wgpu::Instance& instance);
+
+}  // namespace Dusk
@@ -0,0 +1,109 @@
+#include <Dusk/Dots.hpp>
+#include <Dusk/Shader.hpp>
+
+namespace Dusk {
+
+static constexpr const char* DOT_SHADER = R"(
+    @group(0) @binding(0) var<uniform> transformMat: mat4x4f;
+
+    struct DotInput {
+        @location(0) x: f32,
+        @location(1) y: f32,
+        @location(2) size: f32,
+        @location(3) color: vec4f
+    };
+
+    struct VertexOutput {
+        @builtin(position) pos: vec4f,
+        @location(0) uv: vec2f,
+        @location(1) col: vec4f
+    };
+
+    @vertex
+    fn vs_main(@builtin(vertex_index) v: u32, in: DotInput) -> VertexOutput {
+        var out: VertexOutput;
+        let corner = vec2f(f32(v & 1u), f32((v >> 1u) & 1u)) * 2.0 - 1.0;
+        // dots below a pixel are drawn a pixel wide and faded instead, so
+        // they do not flicker in and out of the sample grid
+        let size = max(in.size, 1.0);
+        out.pos = transformMat *
+                  vec4f(vec2f(in.x, in.y) + corner * size * 0.5, 0.0, 1.0);
+        out.uv = corner;
+        out.col = vec4f(in.color.rgb, in.color.a * clamp(in.size, 0.0, 1.0));
+        return out;
+    }
+
+    @fragment
+    fn fs_main(in: VertexOutput) -> @location(0) vec4f {
+        let d = length(in.uv);
+        let mask = clamp((1.0 - d) / max(fwidth(d), 1e-5), 0.0, 1.0);
+        return vec4f(in.col.rgb, in.col.a * mask);
+    }
+)";
+
+wgpu::RenderPipeline createDotPipeline(const RenderContext& context,
+                                       const DotLayout& layout) {
+  wgpu::Device device = context.device;
+  Dusk::Shader shader = Dusk::ShaderBuilder().source(DOT_SHADER).build(device);
+
+  wgpu::VertexAttribute attributes[4];
+  wgpu::VertexBufferLayout buffers[4];
+  const wgpu::VertexFormat formats[4] = {
+      wgpu::VertexFormat::Float32, wgpu::VertexFormat::Float32,
+      wgpu::VertexFormat::Float32, wgpu::VertexFormat::Unorm8x4};
+  const uint64_t strides[4] = {layout.positionStride, layout.positionStride,
+                               layout.sizeStride, layout.colorStride};
+  for (uint32_t i = 0; i < 4; i++) {
+    attributes[i].shaderLocation = i;
+    attributes[i].format = formats[i];
+    attributes[i].offset = 0;
+    buffers[i].attributeCount = 1;
+    buffers[i].attributes = &attributes[i];
+    buffers[i].stepMode = wgpu::VertexStepMode::Instance;
+    buffers[i].arrayStride = strides[i];
+  }
+
+  wgpu::BlendState blend;
+  blend.color.srcFactor = wgpu::BlendFactor::SrcAlpha;
+  blend.color.dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha;
+  blend.color.operation = wgpu::BlendOperation::Add;
+  blend.alpha.srcFactor = wgpu::BlendFactor::One;
+  blend.alpha.dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha;
+  blend.alpha.operation = wgpu::BlendOperation::Add;
+
+  wgpu::ColorTargetState colTarget;
+  colTarget.format = context.format;
+  colTarget.blend = &blend;
+  wgpu::FragmentState frag;
+  frag.module = shader.mod;
+  frag.entryPoint = "fs_main";
+  frag.targetCount = 1;
+  frag.targets = &colTarget;
+
+  wgpu::RenderPipelineDescriptor pipelineDesc;
+  pipelineDesc.vertex.module = shader.mod;
+  pipelineDesc.vertex.entryPoint = "vs_main";
+  pipelineDesc.vertex.bufferCount = 4;
+  pipelineDesc.vertex.buffers = buffers;
+  pipelineDesc.primitive.topology = wgpu::PrimitiveTopology::TriangleStrip;
+  pipelineDesc.fragment = &frag;
+  pipelineDesc.multisample.count = context.sampleCount;
+  pipelineDesc.multisample.mask = ~0u;
+  return device.CreateRenderPipeline(&pipelineDesc);
+}
+
+wgpu::BindGroup createDotBindGroup(const RenderContext& context,
+                                   const wgpu::RenderPipeline& pipeline) {
+  wgpu::BindGroupEntry entry{};
+  entry.binding = 0;
+  entry.buffer = context.transformBuffer;
+  entry.size = sizeof(float) * 16;
+
+  wgpu::BindGroupDescriptor desc{};
+  desc.layout = pipeline.GetBindGroupLayout(0);
+  desc.entryCount = 1;
+  desc.entries = &entry;
+  return context.device.CreateBindGroup(&desc);
+}
+
+}  // namespace Dusk
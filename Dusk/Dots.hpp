@@ -0,0 +1,27 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/Renderable.hpp>
+#include <cstdint>
+
+namespace Dusk {
+
+// Byte strides of the per-instance vertex buffers a dot pipeline reads. The
+// buffers are bound to slots 0 (x), 1 (y), 2 (size) and 3 (color) as f32,
+// f32, f32 and RGBA8. A stride of 0 gives every dot the first element.
+struct DotLayout {
+  uint64_t positionStride = sizeof(float);
+  uint64_t sizeStride = sizeof(float);
+  uint64_t colorStride = sizeof(uint32_t);
+};
+
+// Draws round, antialiased dots as instanced quads with Draw(4, count). Size
+// is the diameter in the units of the drawer's projection.
+wgpu::RenderPipeline createDotPipeline(const RenderContext& context,
+                                       const DotLayout& layout);
+// Binds the drawer's projection for a pipeline from createDotPipeline().
+wgpu::BindGroup createDotBindGroup(const RenderContext& context,
+                                   const wgpu::RenderPipeline& pipeline);
+
+}  // namespace Dusk
@@ -1,7 +1,15 @@
 #pragma once
 
 #include <Dusk/Interface.hpp>
+#include <Dusk/Log.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <span>
 #include <variant>
+#include <vector>
 
 namespace Dusk {
 namespace Drawable {
@@ -27,7 +35,124 @@ class Line : public Interface::Line<Line>,
              public Interface::Color<Line>,
              public Interface::Thickness<Line> {};
 
-typedef std::variant<Rect, Circle, Ellipse, Triangle, Line> Shape;
+class Polygon : public Interface::Path<Polygon>,
+                public Interface::Color<Polygon> {
+ public:
+  // set by the drawer while preparing a frame, see ShapeTraits<Polygon>
+  const std::vector<uint32_t>* triangles = nullptr;
+};
+
+// The built-in shapes, in the order recordings number them. Other types are
+// drawn through ShapeTraits, see ShapeRegistry.hpp.
+typedef std::variant<Rect, Circle, Ellipse, Triangle, Line, Polygon> Shape;
+
+// Many shapes of one kind, queued and tessellated as a single shape with
+// one model matrix, see Drawer::circles(). The spans are read when the frame
+// is drawn and must stay valid until then. Values given per shape hold one
+// element for each shape or a single element for all of them; a batch whose
+// spans do not fit draws nothing. Batches are not recorded.
+namespace Bulk {
+
+inline bool fits(size_t values, size_t count) {
+  return values == count || values == 1;
+}
+
+// value i of a span given per shape
+template <typename T>
+inline const T& at(std::span<const T> values, size_t i) {
+  return values[values.size() == 1 ? 0 : i];
+}
+
+template <typename Batch>
+inline Batch& checked(Batch& batch, const char* name) {
+  if (batch.size() * Batch::POINTS != batch.points()) {
+    DUSK_LOG(LogLevel::Warning, "Dusk",
+             std::format("{}(): per shape values need one element or one for "
+                         "each shape, nothing is drawn",
+                         name));
+  }
+  return batch;
+}
+
+}  // namespace Bulk
+
+class Circles : public Interface::Resolution<Circles> {
+ public:
+  static constexpr size_t POINTS = 1;
+  std::span<const glm::vec2> centers;
+  std::span<const float> radii;
+  std::span<const glm::vec4> colors;
+
+  inline size_t points() const {
+    return centers.size();
+  }
+
+  // the number of circles, 0 when a span does not fit
+  inline size_t size() const {
+    const size_t n = centers.size();
+    return Bulk::fits(radii.size(), n) && Bulk::fits(colors.size(), n) ? n
+                                                                      : 0;
+  }
+};
+
+// corners at positions, extending by sizes
+class Rects {
+ public:
+  static constexpr size_t POINTS = 1;
+  std::span<const glm::vec2> positions;
+  std::span<const glm::vec2> sizes;
+  std::span<const glm::vec4> colors;
+
+  inline size_t points() const {
+    return positions.size();
+  }
+
+  inline size_t size() const {
+    const size_t n = positions.size();
+    return Bulk::fits(sizes.size(), n) && Bulk::fits(colors.size(), n) ? n
+                                                                      : 0;
+  }
+};
+
+// from[i] to to[i]
+class Lines {
+ public:
+  static constexpr size_t POINTS = 1;
+  std::span<const glm::vec2> from;
+  std::span<const glm::vec2> to;
+  std::span<const float> thicknesses;
+  std::span<const glm::vec4> colors;
+
+  inline size_t points() const {
+    return from.size();
+  }
+
+  inline size_t size() const {
+    const size_t n = from.size();
+    return to.size() == n && Bulk::fits(thicknesses.size(), n) &&
+                   Bulk::fits(colors.size(), n)
+               ? n
+               : 0;
+  }
+};
+
+// three consecutive points per triangle, colors per triangle
+class Tris {
+ public:
+  static constexpr size_t POINTS = 3;
+  std::span<const glm::vec2> corners;
+  std::span<const glm::vec4> colors;
+
+  inline size_t points() const {
+    return corners.size();
+  }
+
+  inline size_t size() const {
+    const size_t n = corners.size() / POINTS;
+    return corners.size() % POINTS == 0 && Bulk::fits(colors.size(), n) ? n
+                                                                       : 0;
+  }
+};
 
 }  // namespace Drawable
 }  // namespace Dusk
\ No newline at end of file
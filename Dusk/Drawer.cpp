@@ -1,33 +1,193 @@
 #include <Dusk/Drawer.hpp>
+#include <Dusk/Log.hpp>
 #include <Dusk/Shader.hpp>
+#include <Dusk/TileWriter.hpp>
 #include <glm/ext/matrix_clip_space.hpp>
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/ext/vector_float4.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <format>
 #include <glm/geometric.hpp>
 #include <numbers>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <variant>
 
 namespace Dusk {
 
+// outline vertices a triangulation thread should have to be worth starting
+static constexpr size_t MIN_VERTICES_PER_THREAD = 4096;
+// bounds of the segment counts adaptive resolution picks
+static constexpr uint32_t MIN_SEGMENTS = 3;
+static constexpr uint32_t MAX_SEGMENTS = 4096;
+
+// Segments of a regular polygon whose edges stay within maxError of a
+// circle of the given radius, both in pixels. An edge spanning the angle
+// 2 * pi / n is r * (1 - cos(pi / n)) away from the arc at its middle.
+// No error above zero gets the finest resolution.
+static uint32_t segments(float radius, float maxError) {
+  if (!(maxError > 0)) {
+    return MAX_SEGMENTS;
+  }
+  if (radius <= maxError) {
+    return MIN_SEGMENTS;
+  }
+  float n = std::ceil(std::numbers::pi_v<float> /
+                      std::acos(1.0f - maxError / radius));
+  return std::clamp(static_cast<uint32_t>(n), MIN_SEGMENTS, MAX_SEGMENTS);
+}
+
 Drawer::Drawer(wgpu::Device& device, wgpu::Surface& surface,
-               wgpu::TextureFormat format)
-    : device(device), surface(surface), format(format) {
+               wgpu::TextureFormat format, uint32_t sampleCount,
+               std::shared_ptr<DrawerResources> resources)
+    : device(device),
+      surface(surface),
+      format(format),
+      sampleCount(sampleCount),
+      resources(resources ? resources
+                          : std::make_shared<DrawerResources>(device)),
+      timing(std::make_shared<GpuTiming>()) {
   wgpu::SurfaceTexture surfTex;
   surface.GetCurrentTexture(&surfTex);
+  width = surfTex.texture.GetWidth();
+  height = surfTex.texture.GetHeight();
+  init();
+}
 
-  glm::mat4 ortho = glm::ortho<float>(0, surfTex.texture.GetWidth(),
-                                      surfTex.texture.GetHeight(), 0, -1, 1);
+Drawer::Drawer(wgpu::Device& device, wgpu::TextureFormat format,
+               uint32_t width, uint32_t height, uint32_t sampleCount,
+               std::shared_ptr<DrawerResources> resources)
+    : device(device),
+      format(format),
+      width(width),
+      height(height),
+      sampleCount(sampleCount),
+      resources(resources ? resources
+                          : std::make_shared<DrawerResources>(device)),
+      timing(std::make_shared<GpuTiming>()) {
+  target = this->resources->pool.acquire(
+      {width, height, format, 1,
+       wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::CopySrc |
+           wgpu::TextureUsage::TextureBinding});
+  init();
+}
+
+Drawer::Drawer(std::shared_ptr<RenderBackend> backend, uint32_t width,
+               uint32_t height)
+    : width(width),
+      height(height),
+      backend(backend),
+      timing(std::make_shared<GpuTiming>()) {
+  transform = glm::ortho<float>(0, width, height, 0, -1, 1);
+}
+
+void Drawer::init() {
+  glm::mat4 ortho = glm::ortho<float>(0, width, height, 0, -1, 1);
+  transform = ortho;
 
   transformBuffer = Dusk::Builder::Buffer<float, wgpu::BufferUsage::Uniform>()
                         .data(ortho)
                         .addUsage(wgpu::BufferUsage::CopyDst)
                         .build(device);
 
+  if (!resources->bindGroupLayout) {
+    createLayouts();
+  }
+  bindGroupLayout = resources->bindGroupLayout;
+  layerLayout = resources->layerLayout;
+  tintLayout = resources->tintLayout;
+  sampler = resources->sampler;
+
+  // pipelines depend on the target format and sample count, so drawers that
+  // share resources only build the combinations no other drawer has built.
+  // They compile in the background until the first frame needs them.
+  std::pair key{format, sampleCount};
+  if (!resources->pipelines.contains(key)) {
+    DrawerResources::Pipelines& shared = resources->pipelines[key];
+    createShapePipeline(shared);
+    createCompositePipelines(shared);
+  }
+
+  if (sampleCount > 1) {
+    tex = resources->pool.acquire({width, height, this->format, sampleCount,
+                                   wgpu::TextureUsage::RenderAttachment});
+  }
+
+  // the model buffer always holds at least the identity matrix
+  models.push_back(glm::mat4(1));
+  syncBuffer<glm::mat4, wgpu::BufferUsage::Storage>(modelBuffer, models);
+  models.clear();
+  createBindGroup();
+
+  // slot 0 of the tint buffer is always white
+  std::vector<glm::vec4> tints(tintStride, glm::vec4(1));
+  syncBuffer<glm::vec4, wgpu::BufferUsage::Uniform>(tintBuffer, tints);
+  createTintBindGroup();
+}
+
+void Drawer::createLayouts() {
+  wgpu::BindGroupLayoutEntry bindingLayouts[2];
+  bindingLayouts[0].binding = 0;
+  bindingLayouts[0].visibility = wgpu::ShaderStage::Vertex;
+  bindingLayouts[0].buffer.type = wgpu::BufferBindingType::Uniform;
+  bindingLayouts[0].buffer.minBindingSize = sizeof(float) * 16;
+  bindingLayouts[1].binding = 1;
+  bindingLayouts[1].visibility = wgpu::ShaderStage::Vertex;
+  bindingLayouts[1].buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+  bindingLayouts[1].buffer.minBindingSize = sizeof(glm::mat4);
+
+  // BIND GROUP LAYOUT
+  wgpu::BindGroupLayoutDescriptor bindGroupLayoutDesc{};
+  bindGroupLayoutDesc.entryCount = 2;
+  bindGroupLayoutDesc.entries = bindingLayouts;
+  resources->bindGroupLayout =
+      device.CreateBindGroupLayout(&bindGroupLayoutDesc);
+
+  wgpu::SamplerDescriptor samplerDesc{};
+  samplerDesc.magFilter = wgpu::FilterMode::Linear;
+  samplerDesc.minFilter = wgpu::FilterMode::Linear;
+  resources->sampler = device.CreateSampler(&samplerDesc);
+
+  wgpu::BindGroupLayoutEntry layerEntries[2];
+  layerEntries[0].binding = 0;
+  layerEntries[0].visibility = wgpu::ShaderStage::Fragment;
+  layerEntries[0].sampler.type = wgpu::SamplerBindingType::Filtering;
+  layerEntries[1].binding = 1;
+  layerEntries[1].visibility = wgpu::ShaderStage::Fragment;
+  layerEntries[1].texture.sampleType = wgpu::TextureSampleType::Float;
+  layerEntries[1].texture.viewDimension = wgpu::TextureViewDimension::e2D;
+
+  wgpu::BindGroupLayoutDescriptor layerLayoutDesc{};
+  layerLayoutDesc.entryCount = 2;
+  layerLayoutDesc.entries = layerEntries;
+  resources->layerLayout = device.CreateBindGroupLayout(&layerLayoutDesc);
+
+  wgpu::BindGroupLayoutEntry tintEntry;
+  tintEntry.binding = 0;
+  tintEntry.visibility = wgpu::ShaderStage::Fragment;
+  tintEntry.buffer.type = wgpu::BufferBindingType::Uniform;
+  tintEntry.buffer.hasDynamicOffset = true;
+  tintEntry.buffer.minBindingSize = sizeof(glm::vec4);
+
+  wgpu::BindGroupLayoutDescriptor tintLayoutDesc{};
+  tintLayoutDesc.entryCount = 1;
+  tintLayoutDesc.entries = &tintEntry;
+  resources->tintLayout = device.CreateBindGroupLayout(&tintLayoutDesc);
+}
+
+void Drawer::createShapePipeline(DrawerResources::Pipelines& shared) {
   const char* shaderSource = R"(
     @group(0) @binding(0) var<uniform> transformMat: mat4x4f;
+    @group(0) @binding(1) var<storage, read> models: array<mat4x4f>;
 
     struct VertexInput {
         @location(0) pos: vec3f,
-        @location(1) col: vec4f
+        @location(1) col: vec4f,
+        @location(2) model: u32
     };
 
     struct VertexOutput {
@@ -38,7 +198,7 @@ Drawer::Drawer(wgpu::Device& device, wgpu::Surface& surface,
     @vertex
     fn vs_main(in: VertexInput) -> VertexOutput {
         var out: VertexOutput;
-        out.pos =  transformMat * vec4f(in.pos,1.0);
+        out.pos = transformMat * models[in.model] * vec4f(in.pos, 1.0);
         out.col = in.col;
         return out;
     }
@@ -61,7 +221,12 @@ Drawer::Drawer(wgpu::Device& device, wgpu::Surface& surface,
   colorAttrib.format = wgpu::VertexFormat::Float32x4;
   colorAttrib.offset = 0;
 
-  wgpu::VertexBufferLayout vertexBufferLayouts[2];
+  wgpu::VertexAttribute modelAttrib;
+  modelAttrib.shaderLocation = 2;
+  modelAttrib.format = wgpu::VertexFormat::Uint32;
+  modelAttrib.offset = 0;
+
+  wgpu::VertexBufferLayout vertexBufferLayouts[3];
   vertexBufferLayouts[0].attributeCount = 1;
   vertexBufferLayouts[0].attributes = &positionAttrib;
   vertexBufferLayouts[0].stepMode = wgpu::VertexStepMode::Vertex;
@@ -70,10 +235,14 @@ Drawer::Drawer(wgpu::Device& device, wgpu::Surface& surface,
   vertexBufferLayouts[1].attributes = &colorAttrib;
   vertexBufferLayouts[1].stepMode = wgpu::VertexStepMode::Vertex;
   vertexBufferLayouts[1].arrayStride = 4 * sizeof(float);
+  vertexBufferLayouts[2].attributeCount = 1;
+  vertexBufferLayouts[2].attributes = &modelAttrib;
+  vertexBufferLayouts[2].stepMode = wgpu::VertexStepMode::Vertex;
+  vertexBufferLayouts[2].arrayStride = sizeof(uint32_t);
 
   wgpu::RenderPipelineDescriptor pipelineDesc;
   pipelineDesc.vertex.module = shader.mod;
-  pipelineDesc.vertex.bufferCount = 2;
+  pipelineDesc.vertex.bufferCount = 3;
   pipelineDesc.vertex.buffers = vertexBufferLayouts;
   pipelineDesc.vertex.entryPoint = "vs_main";
 
@@ -92,55 +261,141 @@ Drawer::Drawer(wgpu::Device& device, wgpu::Surface& surface,
   frag.targets = &colTarget;
   pipelineDesc.fragment = &frag;
 
-  wgpu::TextureDescriptor texDesc{};
-  texDesc.usage = wgpu::TextureUsage::RenderAttachment;
-  texDesc.sampleCount = 4;
-  texDesc.format = this->format;
-  wgpu::SurfaceTexture st;
-  surface.GetCurrentTexture(&st);
-  texDesc.size.width = st.texture.GetWidth();
-  texDesc.size.height = st.texture.GetHeight();
-  texDesc.size.depthOrArrayLayers = 1;
-
-  tex = device.CreateTexture(&texDesc);
-
-  pipelineDesc.multisample.count = 4;
+  pipelineDesc.multisample.count = sampleCount;
   pipelineDesc.multisample.mask = ~0u;  // all bits on
   pipelineDesc.multisample.alphaToCoverageEnabled = false;
 
-  wgpu::BindGroupLayoutEntry bindingLayout;
-  bindingLayout.binding = 0;
-  bindingLayout.visibility = wgpu::ShaderStage::Vertex;
-  bindingLayout.buffer.type = wgpu::BufferBindingType::Uniform;
-  bindingLayout.buffer.minBindingSize = sizeof(float) * 16;
+  // PIPELINE LAYOUT
+  wgpu::PipelineLayoutDescriptor layoutDesc{};
+  layoutDesc.bindGroupLayoutCount = 1;
+  layoutDesc.bindGroupLayouts = &bindGroupLayout;
+
+  pipelineDesc.layout = device.CreatePipelineLayout(&layoutDesc);
+  compilePipeline(pipelineDesc, shared.shapes);
+}
 
-  // BIND GROUP LAYOUT
-  wgpu::BindGroupLayoutDescriptor bindGroupLayoutDesc{};
-  bindGroupLayoutDesc.entryCount = 1;
-  bindGroupLayoutDesc.entries = &bindingLayout;
-  wgpu::BindGroupLayout bindGroupLayout =
-      device.CreateBindGroupLayout(&bindGroupLayoutDesc);
+void Drawer::createCompositePipelines(DrawerResources::Pipelines& shared) {
+  const char* shaderSource = R"(
+    @group(0) @binding(0) var layerSampler: sampler;
+    @group(0) @binding(1) var layerTexture: texture_2d<f32>;
+    @group(1) @binding(0) var<uniform> tint: vec4f;
+
+    struct VertexOutput {
+        @builtin(position) pos: vec4f,
+        @location(0) uv: vec2f
+    };
 
-  //
+    // a single triangle covering the whole target
+    @vertex
+    fn vs_main(@builtin(vertex_index) i: u32) -> VertexOutput {
+        var out: VertexOutput;
+        let uv = vec2f(f32((i << 1u) & 2u), f32(i & 2u));
+        out.pos = vec4f(uv * vec2f(2.0, -2.0) + vec2f(-1.0, 1.0), 0.0, 1.0);
+        out.uv = uv;
+        return out;
+    }
+
+    @fragment
+    fn fs_main(in: VertexOutput) -> @location(0) vec4f {
+        return textureSample(layerTexture, layerSampler, in.uv) * tint;
+    })";
+
+  Dusk::Shader shader =
+      Dusk::ShaderBuilder().source(shaderSource).build(device);
+
+  wgpu::BindGroupLayout layouts[2] = {layerLayout, tintLayout};
+  wgpu::PipelineLayoutDescriptor layoutDesc{};
+  layoutDesc.bindGroupLayoutCount = 2;
+  layoutDesc.bindGroupLayouts = layouts;
+
+  wgpu::BlendState blend;
+  blend.color.srcFactor = wgpu::BlendFactor::SrcAlpha;
+  blend.color.dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha;
+  blend.color.operation = wgpu::BlendOperation::Add;
+  blend.alpha.srcFactor = wgpu::BlendFactor::One;
+  blend.alpha.dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha;
+  blend.alpha.operation = wgpu::BlendOperation::Add;
+
+  wgpu::ColorTargetState colTarget;
+  colTarget.format = format;
+  wgpu::FragmentState frag;
+  frag.module = shader.mod;
+  frag.entryPoint = "fs_main";
+  frag.targetCount = 1;
+  frag.targets = &colTarget;
+
+  wgpu::RenderPipelineDescriptor pipelineDesc;
+  pipelineDesc.layout = device.CreatePipelineLayout(&layoutDesc);
+  pipelineDesc.vertex.module = shader.mod;
+  pipelineDesc.vertex.entryPoint = "vs_main";
+  pipelineDesc.primitive.topology = wgpu::PrimitiveTopology::TriangleList;
+  pipelineDesc.fragment = &frag;
+  pipelineDesc.multisample.mask = ~0u;
+
+  // blended into the drawer's own passes
+  colTarget.blend = &blend;
+  pipelineDesc.multisample.count = sampleCount;
+  compilePipeline(pipelineDesc, shared.composite);
+
+  // copies a scaled target onto the surface
+  colTarget.blend = nullptr;
+  pipelineDesc.multisample.count = 1;
+  compilePipeline(pipelineDesc, shared.blit);
+}
+
+void Drawer::compilePipeline(const wgpu::RenderPipelineDescriptor& desc,
+                             wgpu::RenderPipeline& result) {
+  wgpu::CreateRenderPipelineAsyncCallbackInfo callbackInfo{};
+  callbackInfo.mode = wgpu::CallbackMode::WaitAnyOnly;
+  callbackInfo.userdata = &result;
+  callbackInfo.callback = [](WGPUCreatePipelineAsyncStatus status,
+                             WGPURenderPipeline pipeline, const char* message,
+                             void* userdata) {
+    if (status != WGPUCreatePipelineAsyncStatus_Success) {
+      DUSK_LOG(LogLevel::Error, "Dawn::WebGPU",
+               std::format("Unable to create pipeline: {}", message));
+      return;
+    }
+    *static_cast<wgpu::RenderPipeline*>(userdata) =
+        wgpu::RenderPipeline::Acquire(pipeline);
+  };
+  resources->compiling.push_back(
+      device.CreateRenderPipelineAsync(&desc, callbackInfo));
+}
+
+void Drawer::usePipelines() {
+  resources->waitForPipelines();
+  const DrawerResources::Pipelines& shared =
+      resources->pipelines[{format, sampleCount}];
+  pipeline = shared.shapes;
+  compositePipeline = shared.composite;
+  blitPipeline = shared.blit;
+}
+
+DrawerResources::~DrawerResources() {
+  // the callbacks write into the pipeline map
+  waitForPipelines();
+}
+
+void DrawerResources::waitForPipelines() {
+  for (wgpu::Future future : compiling) {
+    instance.WaitAny(future, UINT64_MAX);
+  }
+  compiling.clear();
+}
+
+void Drawer::createTintBindGroup() {
   wgpu::BindGroupEntry binding;
   binding.binding = 0;
-  binding.buffer = transformBuffer;
+  binding.buffer = tintBuffer;
   binding.offset = 0;
-  binding.size = sizeof(float) * 16;
+  binding.size = sizeof(glm::vec4);
 
   wgpu::BindGroupDescriptor bindGroupDesc{};
-  bindGroupDesc.layout = bindGroupLayout;
-  bindGroupDesc.entryCount = bindGroupLayoutDesc.entryCount;
+  bindGroupDesc.layout = tintLayout;
+  bindGroupDesc.entryCount = 1;
   bindGroupDesc.entries = &binding;
-  bindGroup = device.CreateBindGroup(&bindGroupDesc);
-
-  // PIPELINE LAYOUT
-  wgpu::PipelineLayoutDescriptor layoutDesc{};
-  layoutDesc.bindGroupLayoutCount = 1;
-  layoutDesc.bindGroupLayouts = &bindGroupLayout;
-
-  pipelineDesc.layout = device.CreatePipelineLayout(&layoutDesc);
-  pipeline = device.CreateRenderPipeline(&pipelineDesc);
+  tintBindGroup = device.CreateBindGroup(&bindGroupDesc);
 }
 
 Drawer::~Drawer() {
@@ -154,6 +409,27 @@ Drawer::~Drawer() {
   if (colorBuffer) {
     colorBuffer.Destroy();
   }
+  if (modelIdBuffer) {
+    modelIdBuffer.Destroy();
+  }
+}
+
+void Drawer::createBindGroup() {
+  wgpu::BindGroupEntry bindings[2];
+  bindings[0].binding = 0;
+  bindings[0].buffer = transformBuffer;
+  bindings[0].offset = 0;
+  bindings[0].size = sizeof(float) * 16;
+  bindings[1].binding = 1;
+  bindings[1].buffer = modelBuffer;
+  bindings[1].offset = 0;
+  bindings[1].size = modelBuffer.GetSize();
+
+  wgpu::BindGroupDescriptor bindGroupDesc{};
+  bindGroupDesc.layout = bindGroupLayout;
+  bindGroupDesc.entryCount = 2;
+  bindGroupDesc.entries = bindings;
+  bindGroup = device.CreateBindGroup(&bindGroupDesc);
 }
 
 void Drawer::clear(float r, float g, float b, float a) {
@@ -165,70 +441,589 @@ void Drawer::clear(float value, float alpha) {
 };
 
 void Drawer::clear(Rgba color) {
+  if (recorder) {
+    recorder->clear(color.r, color.g, color.b, color.a);
+  }
   loadOp = wgpu::LoadOp::Clear;
   m_clearColor = color;
 }
 
-Drawable::Rect& Drawer::rect() {
-  return shape<Drawable::Rect>();
+Layer Drawer::createLayer() {
+  return createLayer(width, height);
+}
+
+Layer Drawer::createLayer(uint32_t width, uint32_t height) {
+  Layer layer;
+  layer.texture = resources->pool.acquire(
+      {width, height, format, 1,
+       wgpu::TextureUsage::RenderAttachment |
+           wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopySrc |
+           wgpu::TextureUsage::CopyDst});
+  if (sampleCount > 1) {
+    layer.msaa = resources->pool.acquire({width, height, format, sampleCount,
+                               wgpu::TextureUsage::RenderAttachment});
+  }
+
+  layer.bindGroup = createLayerBindGroup(layer.texture);
+  return layer;
+}
+
+wgpu::BindGroup Drawer::createLayerBindGroup(const wgpu::Texture& texture) {
+  wgpu::BindGroupEntry bindings[2];
+  bindings[0].binding = 0;
+  bindings[0].sampler = sampler;
+  bindings[1].binding = 1;
+  bindings[1].textureView = texture.CreateView();
+
+  wgpu::BindGroupDescriptor bindGroupDesc{};
+  bindGroupDesc.layout = layerLayout;
+  bindGroupDesc.entryCount = 2;
+  bindGroupDesc.entries = bindings;
+  return device.CreateBindGroup(&bindGroupDesc);
+}
+
+void Drawer::releaseLayer(Layer& layer) {
+  resources->pool.release(layer.texture);
+  resources->pool.release(layer.msaa);
+  layer = Layer();
+}
+
+void Drawer::composite(const Layer& layer, float alpha) {
+  composite(layer, {1, 1, 1, alpha});
+}
+
+void Drawer::composite(const Layer& layer, Rgba tint) {
+  overlays.push_back({layer.bindGroup, tint, drawableModels.size(), 0});
+}
+
+void Drawer::add(Renderable& renderable) {
+  overlays.push_back({nullptr, {}, drawableModels.size(), 0, &renderable});
+}
+
+RenderContext Drawer::context() {
+  return {device, format, sampleCount, transformBuffer};
+}
+
+void Drawer::record(Recorder* recorder) {
+  this->recorder = recorder;
+}
+
+void Drawer::setPostChain(PostChain* chain) {
+  postChain = chain;
+  if (!postChain && postScene) {
+    releaseLayer(postScene);
+  }
+}
+
+void Drawer::setCanvas(Canvas* canvas) {
+  if (this->canvas && this->canvas != canvas &&
+      this->canvas->device.Get() == device.Get()) {
+    releaseLayer(this->canvas->layer);
+  }
+  this->canvas = canvas;
 }
 
-Drawable::Circle& Drawer::circle() {
-  return shape<Drawable::Circle>();
+void Drawer::enableDynamicResolution(float budgetMs, float minScale) {
+  scaler = DynamicResolution(budgetMs, minScale);
+  dynamicResolution = true;
 }
 
-Drawable::Ellipse& Drawer::ellipse() {
-  return shape<Drawable::Ellipse>();
+void Drawer::enableAdaptiveResolution(float maxError) {
+  maxCurveError = maxError;
+  adaptiveResolution = true;
 }
 
-Drawable::Triangle& Drawer::tri() {
-  return shape<Drawable::Triangle>();
+void Drawer::disableAdaptiveResolution() {
+  adaptiveResolution = false;
 }
 
-Drawable::Line& Drawer::line() {
-  return shape<Drawable::Line>();
+void Drawer::disableDynamicResolution() {
+  dynamicResolution = false;
+  if (scaledTarget) {
+    releaseLayer(scaledTarget);
+  }
 }
 
 void Drawer::draw() {
-  uint32_t startIndex = 0;
-  for (auto drawable : drawables) {
-    if (std::holds_alternative<Drawable::Rect>(*drawable)) {
-      processRect(std::get<Drawable::Rect>(*drawable), startIndex);
-      startIndex += 4;
-    } else if (std::holds_alternative<Drawable::Circle>(*drawable)) {
-      auto c = std::get<Drawable::Circle>(*drawable);
-      processCircle(c, startIndex);
-      startIndex += c.res() + 1;
-    } else if (std::holds_alternative<Drawable::Ellipse>(*drawable)) {
-      auto e = std::get<Drawable::Ellipse>(*drawable);
-      processEllipse(e, startIndex);
-      startIndex += e.res() + 1;
-    } else if (std::holds_alternative<Drawable::Triangle>(*drawable)) {
-      processTriangle(std::get<Drawable::Triangle>(*drawable), startIndex);
-      startIndex += 3;
-    } else if (std::holds_alternative<Drawable::Line>(*drawable)) {
-      processLine(std::get<Drawable::Line>(*drawable), startIndex);
-      startIndex += 4;
+  if (backend) {
+    drawBackend();
+    return;
+  }
+  Drawer* drawers[] = {this};
+  drawAll(drawers);
+}
+
+void Drawer::drawAll(std::span<Drawer* const> drawers) {
+  if (drawers.empty()) {
+    return;
+  }
+  auto start = std::chrono::steady_clock::now();
+
+  wgpu::CommandEncoder encoder = drawers[0]->device.CreateCommandEncoder();
+  std::vector<Layer> retired;
+  for (Drawer* drawer : drawers) {
+    retired.push_back(drawer->encodeFrame(encoder));
+  }
+  wgpu::CommandBuffer commands = encoder.Finish();
+  drawers[0]->device.GetQueue().Submit(1, &commands);
+
+  for (size_t i = 0; i < drawers.size(); i++) {
+    drawers[i]->finishFrame(retired[i], start);
+    // a shared pool ages once per frame rather than once per drawer
+    bool shared = std::any_of(
+        drawers.begin(), drawers.begin() + i, [&](const Drawer* other) {
+          return other->resources == drawers[i]->resources;
+        });
+    if (!shared) {
+      drawers[i]->resources->pool.nextFrame();
     }
   }
+}
 
-  wgpu::Queue queue = device.GetQueue();
+Layer Drawer::encodeFrame(wgpu::CommandEncoder& encoder) {
+  mergeCommandLists();
+  if (recorder) {
+    recordFrame();
+  }
+
+  wgpu::TextureView surfaceView;
+  if (surface) {
+    wgpu::SurfaceTexture surfaceTexture;
+    surface.GetCurrentTexture(&surfaceTexture);
+    surfaceView = surfaceTexture.texture.CreateView();
+  } else {
+    surfaceView = target.CreateView();
+  }
+
+  Layer retired;
+  if (dynamicResolution && !canvas) {
+    retired = resizeScaledTarget();
+  }
+
+  if (canvas) {
+    // may draw the journal with a submit of its own, before this frame's
+    // geometry is uploaded
+    syncCanvas();
+  }
+  prepare();
+  if (dynamicResolution) {
+    beginGpuTimer(encoder);
+  }
+  if (canvas) {
+    encodeCanvas(encoder, surfaceView);
+  } else if (postChain) {
+    if (!dynamicResolution && (postScene.getWidth() != width ||
+                               postScene.getHeight() != height)) {
+      releaseLayer(postScene);
+      postScene = createLayer(width, height);
+    }
+    Layer& scene = dynamicResolution ? scaledTarget : postScene;
+    encodeShapes(encoder, scene);
+    encodePost(encoder, scene, surfaceView);
+  } else if (dynamicResolution) {
+    encodeShapes(encoder, scaledTarget);
+    encodeBlit(encoder, scaledTarget, surfaceView);
+  } else if (sampleCount > 1) {
+    encodeShapes(encoder, tex.CreateView(), surfaceView);
+  } else {
+    encodeShapes(encoder, surfaceView, nullptr);
+  }
+  if (dynamicResolution) {
+    endGpuTimer(encoder);
+  }
+  return retired;
+}
+
+void Drawer::finishFrame(Layer& retired,
+                         std::chrono::steady_clock::time_point start) {
+  submitted();
+  if (retired) {
+    releaseLayer(retired);
+  }
+  if (postChain) {
+    postChain->finish(resources->pool);
+  }
+
+  if (dynamicResolution) {
+    // CPU time spent in this call plus the GPU time last measured
+    std::chrono::duration<double, std::milli> cpu =
+        std::chrono::steady_clock::now() - start;
+    scaler.update(cpu.count() + timing->gpuMs.load());
+    trackGpuTime();
+  }
+  triangulations.nextFrame();
+}
+
+void Drawer::draw(Layer& layer) {
+  mergeCommandLists();
+  if (recorder) {
+    recordFrame(layer.getWidth(), layer.getHeight());
+  }
+  prepare();
+  wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+  encodeShapes(encoder, layer);
+  submit(encoder);
+}
+
+Layer Drawer::resizeScaledTarget() {
+  float scale = scaler.getScale();
+  uint32_t w = std::max(1u, static_cast<uint32_t>(std::lround(width * scale)));
+  uint32_t h = std::max(1u, static_cast<uint32_t>(std::lround(height * scale)));
+  if (scaledTarget && scaledTarget.getWidth() == w &&
+      scaledTarget.getHeight() == h) {
+    return Layer();
+  }
+
+  Layer retired = scaledTarget;
+  scaledTarget = createLayer(w, h);
+  if (retired) {
+    // carry the previous contents over for sketches that never clear
+    overlays.insert(overlays.begin(),
+                    Overlay{retired.bindGroup, {1, 1, 1, 1}, 0, 0});
+  }
+  return retired;
+}
+
+void Drawer::beginGpuTimer(wgpu::CommandEncoder& encoder) {
+  timing->encoded = false;
+  if (!device.HasFeature(wgpu::FeatureName::TimestampQuery) ||
+      timing->pending.load()) {
+    return;
+  }
+  if (!timing->querySet) {
+    wgpu::QuerySetDescriptor queryDesc{};
+    queryDesc.type = wgpu::QueryType::Timestamp;
+    queryDesc.count = 2;
+    timing->querySet = device.CreateQuerySet(&queryDesc);
+    wgpu::BufferDescriptor bufferDesc{};
+    bufferDesc.size = 2 * sizeof(uint64_t);
+    bufferDesc.usage =
+        wgpu::BufferUsage::QueryResolve | wgpu::BufferUsage::CopySrc;
+    timing->resolve = device.CreateBuffer(&bufferDesc);
+    bufferDesc.usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst;
+    timing->readback = device.CreateBuffer(&bufferDesc);
+  }
+  // empty passes that only write a timestamp as they begin
+  wgpu::ComputePassTimestampWrites writes{};
+  writes.querySet = timing->querySet;
+  writes.beginningOfPassWriteIndex = 0;
+  wgpu::ComputePassDescriptor passDesc{};
+  passDesc.timestampWrites = &writes;
+  encoder.BeginComputePass(&passDesc).End();
+  timing->encoded = true;
+}
+
+void Drawer::endGpuTimer(wgpu::CommandEncoder& encoder) {
+  if (!timing->encoded) {
+    return;
+  }
+  wgpu::ComputePassTimestampWrites writes{};
+  writes.querySet = timing->querySet;
+  writes.beginningOfPassWriteIndex = 1;
+  wgpu::ComputePassDescriptor passDesc{};
+  passDesc.timestampWrites = &writes;
+  encoder.BeginComputePass(&passDesc).End();
+  encoder.ResolveQuerySet(timing->querySet, 0, 2, timing->resolve, 0);
+  encoder.CopyBufferToBuffer(timing->resolve, 0, timing->readback, 0,
+                             2 * sizeof(uint64_t));
+}
+
+void Drawer::trackGpuTime() {
+  if (timing->pending.load()) {
+    return;
+  }
+  const bool timestamps = device.HasFeature(wgpu::FeatureName::TimestampQuery);
+  if (timestamps && !timing->encoded) {
+    return;
+  }
+  timing->self = timing;
+  timing->pending.store(true);
+
+  if (timestamps) {
+    timing->encoded = false;
+    wgpu::BufferMapCallbackInfo callbackInfo{};
+    callbackInfo.mode = wgpu::CallbackMode::AllowProcessEvents;
+    callbackInfo.userdata = timing.get();
+    callbackInfo.callback = [](WGPUBufferMapAsyncStatus status,
+                               void* userdata) {
+      auto* slot = static_cast<GpuTiming*>(userdata);
+      std::shared_ptr<GpuTiming> keep = std::move(slot->self);
+      if (status == WGPUBufferMapAsyncStatus_Success) {
+        auto ticks = static_cast<const uint64_t*>(
+            slot->readback.GetConstMappedRange(0, 2 * sizeof(uint64_t)));
+        // nanoseconds, a reset timer can leave end before begin
+        if (ticks[1] > ticks[0]) {
+          slot->gpuMs.store((ticks[1] - ticks[0]) / 1e6);
+        }
+        slot->readback.Unmap();
+      }
+      slot->pending.store(false);
+    };
+    timing->readback.MapAsync(wgpu::MapMode::Read, 0, 2 * sizeof(uint64_t),
+                              callbackInfo);
+    return;
+  }
+
+  // Without timestamps the time from submit until the queue is done, which
+  // includes waiting behind earlier work. Spontaneous, so that it does not
+  // count the wait for the next ProcessEvents().
+  timing->submitted = lastSubmit;
+  wgpu::QueueWorkDoneCallbackInfo callbackInfo{};
+  callbackInfo.mode = wgpu::CallbackMode::AllowSpontaneous;
+  callbackInfo.userdata = timing.get();
+  callbackInfo.callback = [](WGPUQueueWorkDoneStatus status, void* userdata) {
+    auto* slot = static_cast<GpuTiming*>(userdata);
+    std::shared_ptr<GpuTiming> keep = std::move(slot->self);
+    if (status == WGPUQueueWorkDoneStatus_Success) {
+      std::chrono::duration<double, std::milli> gpu =
+          std::chrono::steady_clock::now() - slot->submitted;
+      slot->gpuMs.store(gpu.count());
+    }
+    slot->pending.store(false);
+  };
+  device.GetQueue().OnSubmittedWorkDone(callbackInfo);
+}
+
+void Drawer::triangulatePolygons() {
+  pendingTriangulations.clear();
+  size_t pendingVertices = 0;
+  forEachQueue([&](ShapeRegistry::Buckets& queue, uint32_t) {
+    auto polygons = queue.find<Drawable::Polygon>();
+    if (!polygons) {
+      return;
+    }
+    for (Drawable::Polygon& polygon : polygons->getShapes()) {
+      const auto& outline = polygon.vertices();
+      uint64_t hash = TriangulationCache::hash(outline);
+      if (auto cached = triangulations.find(outline, hash)) {
+        polygon.triangles = cached;
+      } else {
+        pendingTriangulations.push_back({&polygon, hash, {}});
+        pendingVertices += outline.size();
+      }
+    }
+  });
+
+  auto work = [this](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      Triangulation& t = pendingTriangulations[i];
+      triangulate(t.polygon->vertices(), t.indices);
+    }
+  };
+
+  // spread the outlines over threads once there is enough work to pay for
+  // starting them
+  const size_t count = pendingTriangulations.size();
+  const size_t threads =
+      std::min<size_t>({std::thread::hardware_concurrency(), count,
+                        pendingVertices / MIN_VERTICES_PER_THREAD});
+  if (threads <= 1) {
+    work(0, count);
+  } else {
+    std::vector<std::jthread> workers;
+    const size_t chunk = (count + threads - 1) / threads;
+    for (size_t begin = 0; begin < count; begin += chunk) {
+      workers.emplace_back(work, begin, std::min(begin + chunk, count));
+    }
+  }
+
+  for (Triangulation& t : pendingTriangulations) {
+    t.polygon->triangles = &t.indices;
+  }
+}
+
+void Drawer::cacheTriangulations() {
+  for (Triangulation& t : pendingTriangulations) {
+    triangulations.insert(t.polygon->vertices(), t.hash, std::move(t.indices));
+    t.polygon->triangles = nullptr;
+  }
+  pendingTriangulations.clear();
+}
+
+void Drawer::adaptResolution() {
+  // pixels per unit of each model: the longer of its x and y axes once
+  // mapped to the render target
+  const float scale = getResolutionScale();
+  const glm::vec2 viewport(width * 0.5f * scale, height * 0.5f * scale);
+  std::vector<float> pixelScales(models.size());
+  for (size_t i = 0; i < models.size(); i++) {
+    glm::mat4 m = transform * models[i];
+    pixelScales[i] = std::max(glm::length(glm::vec2(m[0]) * viewport),
+                              glm::length(glm::vec2(m[1]) * viewport));
+  }
+
+  auto adapt = [&](auto* bucket, uint32_t base, auto radius) {
+    if (!bucket) {
+      return;
+    }
+    auto& shapes = bucket->getShapes();
+    const auto& ordinals = bucket->getOrdinals();
+    for (size_t i = 0; i < shapes.size(); i++) {
+      if (!shapes[i].hasRes()) {
+        float pixels = radius(shapes[i]) *
+                       pixelScales[drawableModels[base + ordinals[i]]];
+        shapes[i].res(segments(pixels, maxCurveError));
+      }
+    }
+  };
+  forEachQueue([&](ShapeRegistry::Buckets& queue, uint32_t base) {
+    adapt(queue.find<Drawable::Circle>(), base,
+          [](Drawable::Circle& c) { return c.radius(); });
+    adapt(queue.find<Drawable::Ellipse>(), base,
+          [](Drawable::Ellipse& e) { return std::max(e.w(), e.h()); });
+    // one segment count for a whole batch, enough for its largest circle
+    adapt(queue.find<Drawable::Circles>(), base, [](Drawable::Circles& c) {
+      float radius = 0;
+      for (size_t i = 0; i < c.size(); i++) {
+        radius = std::max(radius, Drawable::Bulk::at(c.radii, i));
+      }
+      return radius;
+    });
+  });
+}
+
+void Drawer::tessellate() {
+  // count every shape at its place in the queue, turn the counts into
+  // offsets and let each bucket write its shapes there in one typed loop
+  const size_t count = drawableModels.size();
+  vertexOffsets.assign(count + 1, 0);
+  indexOffsets.assign(count + 1, 0);
+  forEachQueue([&](ShapeRegistry::Buckets& queue, uint32_t base) {
+    queue.forEach([&](ShapeRegistry::Bucket& bucket) {
+      bucket.count(vertexOffsets.data() + base, indexOffsets.data() + base);
+    });
+  });
+  std::exclusive_scan(vertexOffsets.begin(), vertexOffsets.end(),
+                      vertexOffsets.begin(), 0u);
+  std::exclusive_scan(indexOffsets.begin(), indexOffsets.end(),
+                      indexOffsets.begin(), 0u);
+
+  const uint32_t vertexCount = vertexOffsets[count];
+  vertices.resize(vertexCount * 3);
+  colors.resize(vertexCount * 4);
+  indices.resize(indexOffsets[count]);
+  forEachQueue([&](ShapeRegistry::Buckets& queue, uint32_t base) {
+    ShapeRegistry::Geometry geometry{
+        vertices.data(), colors.data(), indices.data(),
+        vertexOffsets.data() + base, indexOffsets.data() + base};
+    queue.forEach(
+        [&](ShapeRegistry::Bucket& bucket) { bucket.tessellate(geometry); });
+  });
+
+  vertexModels.resize(vertexCount);
+  for (size_t i = 0; i < count; i++) {
+    std::fill(vertexModels.begin() + vertexOffsets[i],
+              vertexModels.begin() + vertexOffsets[i + 1], drawableModels[i]);
+  }
+  for (auto& overlay : overlays) {
+    overlay.firstIndex = indexOffsets[overlay.drawable];
+  }
+}
+
+std::vector<std::optional<Drawable::Shape>> Drawer::snapshotShapes() {
+  std::vector<std::optional<Drawable::Shape>> queued(drawableModels.size());
+  forEachQueue([&](ShapeRegistry::Buckets& queue, uint32_t base) {
+    auto out = std::span(queued).subspan(base);
+    queue.forEach([&](ShapeRegistry::Bucket& bucket) { bucket.snapshot(out); });
+  });
+  return queued;
+}
+
+void Drawer::recordFrame(uint32_t layerWidth, uint32_t layerHeight) {
+  if (adaptiveResolution) {
+    // record the segment counts that are actually drawn
+    adaptResolution();
+  }
+  // only the built-in shapes have a recorded form
+  std::vector<std::optional<Drawable::Shape>> queued = snapshotShapes();
+  std::vector<Drawable::Shape> recorded;
+  std::vector<uint32_t> recordedModels;
+  recorded.reserve(queued.size());
+  recordedModels.reserve(queued.size());
+  for (size_t i = 0; i < queued.size(); i++) {
+    if (queued[i]) {
+      recorded.push_back(std::move(*queued[i]));
+      recordedModels.push_back(drawableModels[i]);
+    }
+  }
+  recorder->frame(recorded, recordedModels, models, layerWidth, layerHeight);
+}
+
+void Drawer::buildGeometry() {
+  if (adaptiveResolution) {
+    // no-op for shapes a recorded frame already adapted
+    adaptResolution();
+  }
+  triangulatePolygons();
+
+  tessellate();
+  cacheTriangulations();
+
+  if (models.empty()) {
+    models.push_back(glm::mat4(1));
+  }
+}
+
+void Drawer::prepare() {
+  if (!pipeline) {
+    usePipelines();
+  }
+  buildGeometry();
 
   syncBuffer<float, wgpu::BufferUsage::Vertex>(vertexBuffer, vertices);
   syncBuffer<float, wgpu::BufferUsage::Vertex>(colorBuffer, colors);
+  syncBuffer<uint32_t, wgpu::BufferUsage::Vertex>(modelIdBuffer, vertexModels);
   syncBuffer<uint32_t, wgpu::BufferUsage::Index>(indexBuffer, indices);
+  if (syncBuffer<glm::mat4, wgpu::BufferUsage::Storage>(modelBuffer, models)) {
+    createBindGroup();
+  }
+
+  RenderContext ctx = context();
+  for (auto& overlay : overlays) {
+    if (overlay.renderable) {
+      overlay.renderable->prepare(ctx);
+    }
+  }
 
-  wgpu::SurfaceTexture surfaceTexture;
-  surface.GetCurrentTexture(&surfaceTexture);
+  if (!overlays.empty()) {
+    // one tint per composite after the white one in slot 0, spaced by the
+    // dynamic offset alignment
+    std::vector<glm::vec4> tints((overlays.size() + 1) * tintStride);
+    tints[0] = glm::vec4(1);
+    for (size_t i = 0; i < overlays.size(); i++) {
+      const Rgba& t = overlays[i].tint;
+      tints[(i + 1) * tintStride] = {t.r, t.g, t.b, t.a};
+    }
+    if (syncBuffer<glm::vec4, wgpu::BufferUsage::Uniform>(tintBuffer, tints)) {
+      createTintBindGroup();
+    }
+  }
+}
 
-  wgpu::TextureView view = surfaceTexture.texture.CreateView();
+void Drawer::encodeShapes(wgpu::CommandEncoder& encoder, Layer& layer,
+                          const Region* scissor) {
+  if (sampleCount > 1) {
+    encodeShapes(encoder, layer.msaa.CreateView(), layer.texture.CreateView(),
+                 scissor);
+  } else {
+    encodeShapes(encoder, layer.texture.CreateView(), nullptr, scissor);
+  }
+}
+
+void Drawer::encodeShapes(wgpu::CommandEncoder& encoder,
+                          wgpu::TextureView target,
+                          wgpu::TextureView resolveTarget,
+                          const Region* scissor) {
+  for (auto& overlay : overlays) {
+    if (overlay.renderable) {
+      overlay.renderable->encode(encoder);
+    }
+  }
 
-  // create encoder
-  wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
   // create attachment
   wgpu::RenderPassColorAttachment attachment{};
-  attachment.view = tex.CreateView();
-  attachment.resolveTarget = view;
+  attachment.view = target;
+  attachment.resolveTarget = resolveTarget;
   attachment.loadOp = loadOp;
   attachment.storeOp = wgpu::StoreOp::Store;
   attachment.clearValue = wgpu::Color{m_clearColor.r, m_clearColor.g,
@@ -239,167 +1034,620 @@ void Drawer::draw() {
   renderDesc.colorAttachmentCount = 1;
   renderDesc.colorAttachments = &attachment;
   wgpu::RenderPassEncoder renderPass = encoder.BeginRenderPass(&renderDesc);
-  renderPass.SetPipeline(pipeline);
-  renderPass.SetBindGroup(0, bindGroup);
-  renderPass.SetVertexBuffer(0, vertexBuffer, 0, vertexBuffer.GetSize());
-  renderPass.SetVertexBuffer(1, colorBuffer, 0, colorBuffer.GetSize());
-  renderPass.SetIndexBuffer(indexBuffer, wgpu::IndexFormat::Uint32, 0,
-                            indexBuffer.GetSize());
-  renderPass.DrawIndexed((uint32_t)indices.size(), 1, 0, 0);
+  if (scissor) {
+    renderPass.SetScissorRect(scissor->x0, scissor->y0, scissor->width(),
+                              scissor->height());
+  }
+
+  // shapes are drawn in runs between the queued overlays
+  uint32_t drawn = 0;
+  auto drawShapes = [&](uint32_t end) {
+    if (end <= drawn) {
+      return;
+    }
+    renderPass.SetPipeline(pipeline);
+    renderPass.SetBindGroup(0, bindGroup);
+    renderPass.SetVertexBuffer(0, vertexBuffer, 0, vertexBuffer.GetSize());
+    renderPass.SetVertexBuffer(1, colorBuffer, 0, colorBuffer.GetSize());
+    renderPass.SetVertexBuffer(2, modelIdBuffer, 0, modelIdBuffer.GetSize());
+    renderPass.SetIndexBuffer(indexBuffer, wgpu::IndexFormat::Uint32, 0,
+                              indexBuffer.GetSize());
+    renderPass.DrawIndexed(end - drawn, 1, drawn, 0, 0);
+    drawn = end;
+  };
+
+  for (size_t i = 0; i < overlays.size(); i++) {
+    drawShapes(overlays[i].firstIndex);
+    if (overlays[i].renderable) {
+      overlays[i].renderable->render(renderPass);
+      continue;
+    }
+    uint32_t offset =
+        static_cast<uint32_t>((i + 1) * tintStride * sizeof(glm::vec4));
+    renderPass.SetPipeline(compositePipeline);
+    renderPass.SetBindGroup(0, overlays[i].bindGroup);
+    renderPass.SetBindGroup(1, tintBindGroup, 1, &offset);
+    renderPass.Draw(3);
+  }
+  drawShapes(indices.size());
+  renderPass.End();
+}
+
+void Drawer::encodeBlit(wgpu::CommandEncoder& encoder, const Layer& source,
+                        wgpu::TextureView target) {
+  wgpu::RenderPassColorAttachment attachment{};
+  attachment.view = target;
+  attachment.loadOp = wgpu::LoadOp::Clear;
+  attachment.storeOp = wgpu::StoreOp::Store;
+  attachment.clearValue = wgpu::Color{0, 0, 0, 1};
+
+  wgpu::RenderPassDescriptor renderDesc{};
+  renderDesc.colorAttachmentCount = 1;
+  renderDesc.colorAttachments = &attachment;
+  wgpu::RenderPassEncoder renderPass = encoder.BeginRenderPass(&renderDesc);
+  uint32_t offset = 0;
+  renderPass.SetPipeline(blitPipeline);
+  renderPass.SetBindGroup(0, source.bindGroup);
+  renderPass.SetBindGroup(1, tintBindGroup, 1, &offset);
+  renderPass.Draw(3);
   renderPass.End();
+}
+
+void Drawer::encodePost(wgpu::CommandEncoder& encoder, const Layer& scene,
+                        wgpu::TextureView target) {
+  Layer post;
+  post.texture =
+      postChain->encode(encoder, device, resources->pool, scene.texture);
+  post.bindGroup = post.texture.Get() == scene.texture.Get()
+                       ? scene.bindGroup
+                       : createLayerBindGroup(post.texture);
+  encodeBlit(encoder, post, target);
+}
+
+void Drawer::syncCanvas() {
+  if (!pipeline) {
+    usePipelines();
+  }
+  Layer& layer = canvas->layer;
+  if (layer && (canvas->device.Get() != device.Get() ||
+                layer.texture.GetFormat() != format ||
+                (layer.msaa ? layer.msaa.GetSampleCount() : 1) != sampleCount)) {
+    // made for another device or drawer, which may be gone by now
+    layer = Layer();
+  }
+  if (layer && layer.getWidth() == width && layer.getHeight() == height) {
+    return;
+  }
+
+  Layer previous = layer;
+  layer = createLayer(width, height);
+  canvas->device = device;
+  if (previous) {
+    resizeCanvas(previous);
+    releaseLayer(previous);
+  } else {
+    replayCanvas();
+  }
+}
+
+void Drawer::replayCanvas() {
+  // set the frame queued so far aside and draw the journal on its own
+  ShapeRegistry::Buckets queuedShapes = std::move(shapes);
+  std::vector<uint32_t> queuedModels = std::move(drawableModels);
+  std::vector<glm::mat4> queuedMatrices = std::move(models);
+  std::vector<Overlay> queuedOverlays = std::move(overlays);
+  const wgpu::LoadOp queuedLoadOp = loadOp;
+  const Rgba queuedClearColor = m_clearColor;
+  const bool queuedLists = listsMerged;
+  listsMerged = false;
+  shapes = ShapeRegistry::Buckets();
+  drawableModels.clear();
+  overlays.clear();
+
+  for (Canvas::Entry& entry : canvas->journal) {
+    std::visit(
+        [&](auto& shape) {
+          using T = std::decay_t<decltype(shape)>;
+          const auto ordinal = static_cast<uint32_t>(drawableModels.size());
+          shapes.get<T>().add(ordinal) = shape;
+        },
+        entry.shape);
+    drawableModels.push_back(entry.model);
+  }
+  models = canvas->models;
+  const glm::vec4& c = canvas->clearColor;
+  loadOp = wgpu::LoadOp::Clear;
+  m_clearColor = {c.r, c.g, c.b, c.a};
+
+  prepare();
+  wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+  encodeShapes(encoder, canvas->layer);
+  wgpu::CommandBuffer commands = encoder.Finish();
+  device.GetQueue().Submit(1, &commands);
+
+  shapes = std::move(queuedShapes);
+  drawableModels = std::move(queuedModels);
+  models = std::move(queuedMatrices);
+  overlays = std::move(queuedOverlays);
+  loadOp = queuedLoadOp;
+  m_clearColor = queuedClearColor;
+  listsMerged = queuedLists;
+}
+
+void Drawer::resizeCanvas(Layer& previous) {
+  Layer& layer = canvas->layer;
+  const glm::vec4& c = canvas->clearColor;
+  wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+
+  // clear whatever the pooled textures held, then copy over the part of the
+  // old canvas that still fits
+  wgpu::RenderPassColorAttachment attachment{};
+  attachment.view =
+      layer.msaa ? layer.msaa.CreateView() : layer.texture.CreateView();
+  attachment.resolveTarget = layer.msaa ? layer.texture.CreateView() : nullptr;
+  attachment.loadOp = wgpu::LoadOp::Clear;
+  attachment.storeOp = wgpu::StoreOp::Store;
+  attachment.clearValue = wgpu::Color{c.r, c.g, c.b, c.a};
+  wgpu::RenderPassDescriptor renderDesc{};
+  renderDesc.colorAttachmentCount = 1;
+  renderDesc.colorAttachments = &attachment;
+  encoder.BeginRenderPass(&renderDesc).End();
+
+  wgpu::ImageCopyTexture source{};
+  source.texture = previous.texture;
+  wgpu::ImageCopyTexture destination{};
+  destination.texture = layer.texture;
+  wgpu::Extent3D size{std::min(previous.getWidth(), width),
+                      std::min(previous.getHeight(), height), 1};
+  encoder.CopyTextureToTexture(&source, &destination, &size);
+
+  if (layer.msaa) {
+    // Multisampled textures cannot be copied into. Draw the resolved copy
+    // into the new samples instead, which later frames load and resolve.
+    attachment.resolveTarget = nullptr;
+    wgpu::RenderPassEncoder renderPass = encoder.BeginRenderPass(&renderDesc);
+    uint32_t offset = 0;
+    renderPass.SetPipeline(compositePipeline);
+    renderPass.SetBindGroup(0, layer.bindGroup);
+    renderPass.SetBindGroup(1, tintBindGroup, 1, &offset);
+    renderPass.Draw(3);
+    renderPass.End();
+  }
+
+  wgpu::CommandBuffer commands = encoder.Finish();
+  device.GetQueue().Submit(1, &commands);
+}
+
+void Drawer::journalFrame() {
+  if (loadOp == wgpu::LoadOp::Clear) {
+    canvas->journal.clear();
+    canvas->models.clear();
+    canvas->clearColor = {m_clearColor.r, m_clearColor.g, m_clearColor.b,
+                          m_clearColor.a};
+    canvas->journalDropped = false;
+  }
+  if (!canvas->isJournaled()) {
+    return;
+  }
+
+  // each model the journaled shapes use is appended once, or not at all
+  // when it matches the last one
+  std::vector<std::optional<Drawable::Shape>> queued = snapshotShapes();
+  std::vector<uint32_t> journaled(models.size(), UINT32_MAX);
+  for (size_t i = 0; i < queued.size(); i++) {
+    if (!queued[i]) {
+      continue;
+    }
+    uint32_t& model = journaled[drawableModels[i]];
+    if (model == UINT32_MAX) {
+      const glm::mat4& m = models[drawableModels[i]];
+      if (canvas->models.empty() || canvas->models.back() != m) {
+        canvas->models.push_back(m);
+      }
+      model = static_cast<uint32_t>(canvas->models.size() - 1);
+    }
+    canvas->journal.push_back({std::move(*queued[i]), model});
+  }
+
+  if (canvas->journal.size() > canvas->journalLimit) {
+    DUSK_LOG(LogLevel::Warning, "Dusk",
+             std::format("Canvas journal passed {} shapes and was dropped, "
+                         "a new device starts from a cleared canvas",
+                         canvas->journalLimit));
+    canvas->journal = {};
+    canvas->models = {};
+    canvas->journalDropped = true;
+  }
+}
+
+Region Drawer::damagedRegion() {
+  const Region whole{0, 0, width, height};
+  if (loadOp == wgpu::LoadOp::Clear || !overlays.empty()) {
+    // composites and renderables may cover anything
+    return whole;
+  }
+  if (indices.empty()) {
+    return {};
+  }
+
+  std::vector<glm::mat4> matrices(models.size());
+  for (size_t i = 0; i < models.size(); i++) {
+    matrices[i] = transform * models[i];
+  }
+  float minX = INFINITY;
+  float minY = INFINITY;
+  float maxX = -INFINITY;
+  float maxY = -INFINITY;
+  for (size_t i = 0; i < vertexModels.size(); i++) {
+    glm::vec4 p = matrices[vertexModels[i]] *
+                  glm::vec4(vertices[i * 3], vertices[i * 3 + 1],
+                            vertices[i * 3 + 2], 1.0f);
+    minX = std::min(minX, p.x / p.w);
+    minY = std::min(minY, p.y / p.w);
+    maxX = std::max(maxX, p.x / p.w);
+    maxY = std::max(maxY, p.y / p.w);
+  }
+
+  // normalized device coordinates to pixels, y pointing down, with a pixel
+  // of margin for multisampled edges
+  auto pixel = [](float ndc, float size, float margin) {
+    float p = (ndc * 0.5f + 0.5f) * size + margin;
+    return static_cast<uint32_t>(std::clamp(p, 0.0f, size));
+  };
+  const float w = static_cast<float>(width);
+  const float h = static_cast<float>(height);
+  return {pixel(minX, w, -1), pixel(-maxY, h, -1), pixel(maxX, w, 2),
+          pixel(-minY, h, 2)};
+}
+
+void Drawer::encodeCanvas(wgpu::CommandEncoder& encoder,
+                          wgpu::TextureView target) {
+  canvas->damage = damagedRegion();
+  journalFrame();
+  if (!canvas->damage.empty()) {
+    encodeShapes(encoder, canvas->layer, &canvas->damage);
+  }
+  if (postChain) {
+    encodePost(encoder, canvas->layer, target);
+  } else {
+    encodeBlit(encoder, canvas->layer, target);
+  }
+}
+
+void Drawer::resize(uint32_t width, uint32_t height) {
+  if (width == 0 || height == 0 ||
+      (width == this->width && height == this->height)) {
+    return;
+  }
+  const glm::mat4 previous =
+      glm::ortho<float>(0, this->width, this->height, 0, -1, 1);
+  this->width = width;
+  this->height = height;
+
+  if (tex) {
+    resources->pool.release(tex);
+    tex = resources->pool.acquire({width, height, format, sampleCount,
+                                   wgpu::TextureUsage::RenderAttachment});
+  }
+  if (target) {
+    resources->pool.release(target);
+    target = resources->pool.acquire(
+        {width, height, format, 1,
+         wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::CopySrc |
+             wgpu::TextureUsage::TextureBinding});
+  }
+  if (transform == previous) {
+    setTransformMatrix(glm::ortho<float>(0, width, height, 0, -1, 1));
+  }
+}
+
+void Drawer::drawBackend() {
+  mergeCommandLists();
+  if (recorder) {
+    recordFrame();
+  }
+  buildGeometry();
+  if (!overlays.empty()) {
+    DUSK_LOG(LogLevel::Warning, "Dusk",
+             "Composites and renderables need a device, skipped");
+  }
+
+  BackendFrame frame{width,
+                     height,
+                     vertices,
+                     colors,
+                     vertexModels,
+                     indices,
+                     models,
+                     transform,
+                     loadOp == wgpu::LoadOp::Clear,
+                     {m_clearColor.r, m_clearColor.g, m_clearColor.b,
+                      m_clearColor.a}};
+  backend->draw(frame);
+  submitted();
+  triangulations.nextFrame();
+}
+
+bool Drawer::drawTiled(const std::string& path, uint32_t imageWidth,
+                       uint32_t imageHeight) {
+  const bool bgra = format == wgpu::TextureFormat::BGRA8Unorm;
+  if (imageWidth == 0 || imageHeight == 0) {
+    flushData();
+    return false;
+  }
+  if (!target || (!bgra && format != wgpu::TextureFormat::RGBA8Unorm)) {
+    DUSK_LOG(LogLevel::Error, "Dusk",
+             "Tiled drawing needs a headless drawer with an 8 bit RGBA or "
+             "BGRA format");
+    flushData();
+    return false;
+  }
+  TileWriter writer(path, imageWidth, imageHeight);
+  if (!writer) {
+    flushData();
+    return false;
+  }
+  if (!overlays.empty()) {
+    DUSK_LOG(LogLevel::Warning, "Dusk",
+             "Composites and renderables are not drawn into tiles");
+    overlays.clear();
+  }
+  if (!pipeline) {
+    usePipelines();
+  }
+
+  // lay the frame out on the whole image, adaptive resolution included
+  mergeCommandLists();
+  const glm::mat4 imageTransform =
+      transform == glm::ortho<float>(0, width, height, 0, -1, 1)
+          ? glm::ortho<float>(0, imageWidth, imageHeight, 0, -1, 1)
+          : transform;
+  const glm::mat4 ownTransform = transform;
+  const uint32_t tileWidth = width;
+  const uint32_t tileHeight = height;
+  transform = imageTransform;
+  width = imageWidth;
+  height = imageHeight;
+  buildGeometry();
+  transform = ownTransform;
+  width = tileWidth;
+  height = tileHeight;
+
+  const uint32_t columns = (imageWidth + tileWidth - 1) / tileWidth;
+  const uint32_t rows = (imageHeight + tileHeight - 1) / tileHeight;
+  std::vector<std::vector<uint32_t>> bins =
+      binShapes(imageTransform, imageWidth, imageHeight, columns);
+
+  // the geometry is uploaded once, each tile only writes the indices of its
+  // shapes, into a buffer already large enough for all of them
+  syncBuffer<float, wgpu::BufferUsage::Vertex>(vertexBuffer, vertices);
+  syncBuffer<float, wgpu::BufferUsage::Vertex>(colorBuffer, colors);
+  syncBuffer<uint32_t, wgpu::BufferUsage::Vertex>(modelIdBuffer, vertexModels);
+  syncBuffer<uint32_t, wgpu::BufferUsage::Index>(indexBuffer, indices);
+  if (syncBuffer<glm::mat4, wgpu::BufferUsage::Storage>(modelBuffer, models)) {
+    createBindGroup();
+  }
+  const std::vector<uint32_t> frameIndices = std::move(indices);
+  loadOp = wgpu::LoadOp::Clear;
+
+  // two readback buffers, so one tile renders while the last is written
+  const uint32_t bytesPerRow = (tileWidth * 4 + 255) / 256 * 256;
+  wgpu::BufferDescriptor readbackDesc{};
+  readbackDesc.size = static_cast<uint64_t>(bytesPerRow) * tileHeight;
+  readbackDesc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead;
+  std::array<wgpu::Buffer, 2> readbacks = {
+      device.CreateBuffer(&readbackDesc), device.CreateBuffer(&readbackDesc)};
+
+  wgpu::Queue queue = device.GetQueue();
+  auto writeTile = [&](uint32_t tile) {
+    const wgpu::Buffer& readback = readbacks[tile % 2];
+    bool mapped = false;
+    wgpu::BufferMapCallbackInfo callbackInfo{};
+    callbackInfo.mode = wgpu::CallbackMode::WaitAnyOnly;
+    callbackInfo.userdata = &mapped;
+    callbackInfo.callback = [](WGPUBufferMapAsyncStatus status,
+                               void* userdata) {
+      *static_cast<bool*>(userdata) =
+          status == WGPUBufferMapAsyncStatus_Success;
+    };
+    resources->instance.WaitAny(
+        readback.MapAsync(wgpu::MapMode::Read, 0, readbackDesc.size,
+                          callbackInfo),
+        UINT64_MAX);
+    if (!mapped) {
+      DUSK_LOG(LogLevel::Error, "Dawn::WebGPU",
+               std::format("Unable to read tile {} back", tile));
+      return false;
+    }
+    auto pixels = static_cast<const uint8_t*>(
+        readback.GetConstMappedRange(0, readbackDesc.size));
+    bool written = writer.write(tile % columns * tileWidth,
+                                tile / columns * tileHeight, tileWidth,
+                                tileHeight, pixels, bytesPerRow, bgra);
+    readback.Unmap();
+    return written;
+  };
+
+  bool ok = true;
+  const uint32_t tiles = columns * rows;
+  for (uint32_t tile = 0; tile < tiles && ok; tile++) {
+    indices.clear();
+    for (uint32_t shape : bins[tile]) {
+      indices.insert(indices.end(), frameIndices.begin() + indexOffsets[shape],
+                     frameIndices.begin() + indexOffsets[shape + 1]);
+    }
+    syncBuffer<uint32_t, wgpu::BufferUsage::Index>(indexBuffer, indices);
+
+    // maps the tile's part of the image to clip space
+    const float x0 = static_cast<float>(tile % columns * tileWidth);
+    const float y0 = static_cast<float>(tile / columns * tileHeight);
+    glm::mat4 crop(1);
+    crop[0][0] = static_cast<float>(imageWidth) / tileWidth;
+    crop[1][1] = static_cast<float>(imageHeight) / tileHeight;
+    crop[3][0] = (imageWidth - 2 * x0) / tileWidth - 1;
+    crop[3][1] = 1 - (imageHeight - 2 * y0) / tileHeight;
+    glm::mat4 tileTransform = crop * imageTransform;
+    queue.WriteBuffer(transformBuffer, 0, &tileTransform[0][0],
+                      sizeof(float) * 16);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    if (sampleCount > 1) {
+      encodeShapes(encoder, tex.CreateView(), target.CreateView());
+    } else {
+      encodeShapes(encoder, target.CreateView(), nullptr);
+    }
+    wgpu::ImageCopyTexture source{};
+    source.texture = target;
+    wgpu::ImageCopyBuffer destination{};
+    destination.buffer = readbacks[tile % 2];
+    destination.layout.bytesPerRow = bytesPerRow;
+    destination.layout.rowsPerImage = tileHeight;
+    wgpu::Extent3D size{tileWidth, tileHeight, 1};
+    encoder.CopyTextureToBuffer(&source, &destination, &size);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    if (tile > 0) {
+      ok = writeTile(tile - 1);
+    }
+  }
+  if (ok && tiles > 0) {
+    ok = writeTile(tiles - 1);
+  }
+
+  for (wgpu::Buffer& readback : readbacks) {
+    readback.Destroy();
+  }
+  queue.WriteBuffer(transformBuffer, 0, &transform[0][0], sizeof(float) * 16);
+  submitted();
+  triangulations.nextFrame();
+  resources->pool.nextFrame();
+  return ok;
+}
+
+std::vector<std::vector<uint32_t>> Drawer::binShapes(
+    const glm::mat4& imageTransform, uint32_t imageWidth,
+    uint32_t imageHeight, uint32_t columns) {
+  const uint32_t rows = (imageHeight + height - 1) / height;
+  std::vector<std::vector<uint32_t>> bins(columns * rows);
+  std::vector<glm::mat4> matrices(models.size());
+  for (size_t i = 0; i < models.size(); i++) {
+    matrices[i] = imageTransform * models[i];
+  }
+
+  const float w = static_cast<float>(imageWidth);
+  const float h = static_cast<float>(imageHeight);
+  const size_t count = drawableModels.size();
+  for (size_t shape = 0; shape < count; shape++) {
+    const glm::mat4& m = matrices[drawableModels[shape]];
+    float minX = INFINITY;
+    float minY = INFINITY;
+    float maxX = -INFINITY;
+    float maxY = -INFINITY;
+    bool behind = false;
+    for (uint32_t v = vertexOffsets[shape]; v < vertexOffsets[shape + 1];
+         v++) {
+      glm::vec4 p = m * glm::vec4(vertices[v * 3], vertices[v * 3 + 1],
+                                  vertices[v * 3 + 2], 1.0f);
+      behind |= p.w <= 0;
+      // pixels on the image, y pointing down
+      float x = (p.x / p.w * 0.5f + 0.5f) * w;
+      float y = (0.5f - p.y / p.w * 0.5f) * h;
+      minX = std::min(minX, x);
+      minY = std::min(minY, y);
+      maxX = std::max(maxX, x);
+      maxY = std::max(maxY, y);
+    }
+    if (behind) {
+      // the projection gives no bounds, draw it everywhere
+      minX = minY = 0;
+      maxX = w;
+      maxY = h;
+    }
+    // a pixel of margin for multisampled edges
+    if (!(maxX >= -1 && maxY >= -1 && minX <= w + 1 && minY <= h + 1)) {
+      continue;
+    }
+    auto tileOf = [](float pixel, uint32_t size, uint32_t tiles) {
+      float t = std::floor(pixel / size);
+      return static_cast<uint32_t>(
+          std::clamp(t, 0.0f, static_cast<float>(tiles - 1)));
+    };
+    const uint32_t c0 = tileOf(minX - 1, width, columns);
+    const uint32_t c1 = tileOf(maxX + 1, width, columns);
+    const uint32_t r0 = tileOf(minY - 1, height, rows);
+    const uint32_t r1 = tileOf(maxY + 1, height, rows);
+    for (uint32_t r = r0; r <= r1; r++) {
+      for (uint32_t c = c0; c <= c1; c++) {
+        bins[r * columns + c].push_back(static_cast<uint32_t>(shape));
+      }
+    }
+  }
+  return bins;
+}
+
+void Drawer::submit(wgpu::CommandEncoder& encoder) {
   wgpu::CommandBuffer commands = encoder.Finish();
-  queue.Submit(1, &commands);
+  device.GetQueue().Submit(1, &commands);
+  submitted();
+}
+
+void Drawer::submitted() {
+  lastSubmit = std::chrono::steady_clock::now();
   flushData();
   loadOp = wgpu::LoadOp::Load;
-};
+}
 
 void Drawer::setTransformMatrix(glm::mat4 mat) {
-  std::vector<float> data;
-  for (int i = 0; i < 4; i++) {
-    for (int j = 0; j < 4; j++) {
-      data.push_back(mat[i][j]);
-    }
+  if (recorder) {
+    recorder->transform(mat);
+  }
+  transform = mat;
+  if (!transformBuffer) {
+    // drawn by a backend, which takes the CPU copy
+    return;
   }
   wgpu::Queue queue = device.GetQueue();
-  queue.WriteBuffer(transformBuffer, 0, data.data(), sizeof(float) * 16);
+  queue.WriteBuffer(transformBuffer, 0, &mat[0][0], sizeof(float) * 16);
+}
+
+CommandList& Drawer::commandList(size_t index) {
+  while (commandLists.size() <= index) {
+    commandLists.push_back(std::make_shared<CommandList>());
+  }
+  return *commandLists[index];
+}
+
+void Drawer::mergeCommandLists() {
+  if (listsMerged) {
+    return;
+  }
+  // Each list's shapes and models follow those before it. The shapes stay
+  // in the lists' arenas, only the model indices are rebased.
+  for (auto& list : commandLists) {
+    list->base = static_cast<uint32_t>(drawableModels.size());
+    const auto modelBase = static_cast<uint32_t>(models.size());
+    models.insert(models.end(), list->models.begin(), list->models.end());
+    for (uint32_t model : list->drawableModels) {
+      drawableModels.push_back(modelBase + model);
+    }
+  }
+  listsMerged = true;
+  // shapes queued on the drawer from here on need a model of their own
+  matrixDirty = true;
 }
 
 void Drawer::flushData() {
   vertices.clear();
   indices.clear();
   colors.clear();
-  drawables.clear();
-}
-
-void Drawer::processRect(Drawable::Rect& r, uint32_t startIndex) {
-  // vertex 0
-  vertices.push_back(r.x());
-  vertices.push_back(r.y());
-  vertices.push_back(r.z());
-  // vertex 1
-  vertices.push_back(r.x() + r.w());
-  vertices.push_back(r.y());
-  vertices.push_back(r.z());
-  // vertex 2
-  vertices.push_back(r.x() + r.w());
-  vertices.push_back(r.y() + r.h());
-  vertices.push_back(r.z());
-  // vertex 3
-  vertices.push_back(r.x());
-  vertices.push_back(r.y() + r.h());
-  vertices.push_back(r.z());
-
-  // 4 vertices
-  const std::vector<float> rgba = {r.r(), r.g(), r.b(), r.a()};
-  for (int i = 0; i < 4; i++) {
-    colors.insert(colors.end(), rgba.begin(), rgba.end());
-  }
-
-  indices.insert(indices.end(), {startIndex, startIndex + 1, startIndex + 2,
-                                 startIndex, startIndex + 2, startIndex + 3});
-}
-
-void Drawer::processCircle(Drawable::Circle& c, uint32_t startIndex) {
-  const float x = c.x();
-  const float y = c.y();
-  const float z = c.z();
-  const float r = c.r();
-  const float g = c.g();
-  const float b = c.b();
-  const float a = c.a();
-  const float radius = c.radius();
-  const uint32_t res = c.res();
-
-  vertices.insert(vertices.end(), {x, y, z});
-  for (uint32_t i = 0; i < res; i++) {
-    float id = static_cast<float>(i) / static_cast<float>(res);
-    float theta = id * std::numbers::pi_v<float> * 2.0;
-    vertices.insert(vertices.end(),
-                    {cosf(theta) * radius + x, sinf(theta) * radius + y, z});
-  }
-
-  for (uint32_t i = 0; i <= res; i++) {
-    colors.insert(colors.end(), {r, g, b, a});
-  }
-
-  for (uint32_t i = 0; i < res; i++) {
-    uint32_t i1 = startIndex;
-    uint32_t i2 = startIndex + i + 1;
-    uint32_t i3 = startIndex + (i + 1) % res + 1;
-    indices.insert(indices.end(), {i1, i2, i3});
-  }
-}
-
-void Drawer::processEllipse(Drawable::Ellipse& e, uint32_t startIndex) {
-  const float x = e.x();
-  const float y = e.y();
-  const float z = e.z();
-  const float r = e.r();
-  const float g = e.g();
-  const float b = e.b();
-  const float a = e.a();
-  const float w = e.w();
-  const float h = e.h();
-  const uint32_t res = e.res();
-
-  vertices.insert(vertices.end(), {x, y, z});
-  for (uint32_t i = 0; i < res; i++) {
-    float id = static_cast<float>(i) / static_cast<float>(res);
-    float theta = id * std::numbers::pi_v<float> * 2.0;
-    vertices.insert(vertices.end(),
-                    {cosf(theta) * w + x, sinf(theta) * h + y, z});
-  }
-
-  for (uint32_t i = 0; i <= res; i++) {
-    colors.insert(colors.end(), {r, g, b, a});
-  }
-
-  for (uint32_t i = 0; i < res; i++) {
-    uint32_t i1 = startIndex;
-    uint32_t i2 = startIndex + i + 1;
-    uint32_t i3 = startIndex + (i + 1) % res + 1;
-    indices.insert(indices.end(), {i1, i2, i3});
-  }
-}
-
-void Drawer::processTriangle(Drawable::Triangle& t, uint32_t startIndex) {
-  const auto [x1, y1, z1] = t.p1<Triplet>();
-  const auto [x2, y2, z2] = t.p2<Triplet>();
-  const auto [x3, y3, z3] = t.p3<Triplet>();
-  vertices.insert(vertices.end(), {x1, y1, z1});
-  vertices.insert(vertices.end(), {x2, y2, z2});
-  vertices.insert(vertices.end(), {x3, y3, z3});
-  const std::vector<float> rgba = {t.r(), t.g(), t.b(), t.a()};
-  for (int i = 0; i < 3; i++) {
-    colors.insert(colors.end(), rgba.begin(), rgba.end());
-  }
-  indices.insert(indices.end(), {startIndex, startIndex + 1, startIndex + 2});
-}
-
-void Drawer::processLine(Drawable::Line& l, uint32_t startIndex) {
-  const auto p1 = l.p1<glm::vec3>();
-  const auto p2 = l.p2<glm::vec3>();
-  glm::vec3 dir = glm::normalize(p2 - p1) * glm::vec3(l.thickness() * 0.5f);
-  glm::vec3 bitan =
-      glm::rotate(glm::mat4(1), std::numbers::pi_v<float> * 0.5f, {0, 0, 1}) *
-      glm::vec4(dir, 1);
-
-  const auto px1 = p1 + bitan;
-  const auto px2 = p2 + bitan;
-  const auto px3 = p2 - bitan;
-  const auto px4 = p1 - bitan;
-  vertices.insert(vertices.end(), {px1.x, px1.y, px1.z});
-  vertices.insert(vertices.end(), {px2.x, px2.y, px2.z});
-  vertices.insert(vertices.end(), {px3.x, px3.y, px3.z});
-  vertices.insert(vertices.end(), {px4.x, px4.y, px4.z});
-
-  const std::vector<float> rgba = {l.r(), l.g(), l.b(), l.a()};
-  for (int i = 0; i < 4; i++) {
-    colors.insert(colors.end(), rgba.begin(), rgba.end());
+  vertexModels.clear();
+  clearQueue();
+  for (auto& list : commandLists) {
+    list->clear();
   }
-
-  indices.insert(indices.end(), {startIndex, startIndex + 1, startIndex + 2,
-                                 startIndex, startIndex + 2, startIndex + 3});
+  listsMerged = false;
+  overlays.clear();
 }
 
-}  // namespace Dusk
\ No newline at end of file
+}  // namespace Dusk
@@ -2,16 +2,69 @@
 
 #include <webgpu/webgpu_cpp.h>
 
+#include <Dusk/Backend.hpp>
 #include <Dusk/Builder/Buffer.hpp>
+#include <Dusk/Canvas.hpp>
+#include <Dusk/CommandList.hpp>
 #include <Dusk/Drawables.hpp>
+#include <Dusk/DynamicResolution.hpp>
+#include <Dusk/Layer.hpp>
+#include <Dusk/PostChain.hpp>
+#include <Dusk/Recording.hpp>
+#include <Dusk/Renderable.hpp>
+#include <Dusk/ShapeQueue.hpp>
+#include <Dusk/ShapeRegistry.hpp>
+#include <Dusk/TexturePool.hpp>
+#include <Dusk/Triangulate.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <cstdint>
 #include <glm/ext/matrix_float4x4.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace Dusk {
 
+// Pipelines and textures that drawers on one device can share, e.g. the
+// drawers of several windows. Pass one drawer's getResources() to the
+// constructor of the next.
+struct DrawerResources {
+  explicit DrawerResources(wgpu::Device& device)
+      : instance(device.GetAdapter().GetInstance()), pool(device) {}
+  ~DrawerResources();
+  DrawerResources(const DrawerResources&) = delete;
+  DrawerResources& operator=(const DrawerResources&) = delete;
+
+  struct Pipelines {
+    wgpu::RenderPipeline shapes;
+    wgpu::RenderPipeline composite;
+    wgpu::RenderPipeline blit;
+  };
+
+  // Blocks until the pipelines compiling in the background are done.
+  void waitForPipelines();
+
+  wgpu::Instance instance;
+  TexturePool pool;
+  wgpu::BindGroupLayout bindGroupLayout;
+  wgpu::BindGroupLayout layerLayout;
+  wgpu::BindGroupLayout tintLayout;
+  wgpu::Sampler sampler;
+  // by target format and sample count, map nodes stay put while the
+  // pipelines compile into them
+  std::map<std::pair<wgpu::TextureFormat, uint32_t>, Pipelines> pipelines;
+  std::vector<wgpu::Future> compiling;
+};
+
 struct Rgba {
   float r;
   float g;
@@ -19,67 +72,235 @@ struct Rgba {
   float a;
 };
 
-class Drawer {
+class Drawer : public ShapeQueue {
  public:
   Drawer() = default;
   ~Drawer();
   Drawer(wgpu::Device& device, wgpu::Surface& surface,
-         wgpu::TextureFormat format);
+         wgpu::TextureFormat format, uint32_t sampleCount = 4,
+         std::shared_ptr<DrawerResources> resources = nullptr);
+  // Headless drawer rendering into its own texture instead of a surface.
+  Drawer(wgpu::Device& device, wgpu::TextureFormat format, uint32_t width,
+         uint32_t height, uint32_t sampleCount = 4,
+         std::shared_ptr<DrawerResources> resources = nullptr);
+  // Drawer without a device, handing the tessellated shapes of every frame
+  // to a backend such as SoftwareRasterizer. Layers, composites,
+  // renderables, post chains and canvases need a device and are not
+  // available, dynamic resolution does not apply.
+  Drawer(std::shared_ptr<RenderBackend> backend, uint32_t width,
+         uint32_t height);
 
   void clear(float r, float g, float b, float a = 1.0);
   void clear(float value, float alpha = 1.0);
   void clear(Rgba color);
 
-  template <typename T>
-  T& shape() {
-    if constexpr (!std::is_same_v<T, Drawable::Rect> &&
-                  !std::is_same_v<T, Drawable::Circle> &&
-                  !std::is_same_v<T, Drawable::Ellipse> &&
-                  !std::is_same_v<T, Drawable::Triangle> &&
-                  !std::is_same_v<T, Drawable::Line>) {
-      static_assert(always_false<T>::value, "Unsupported type");
-    }
-    Drawable::Shape s = T();
-    auto ptr = std::make_shared<Drawable::Shape>(s);
-    drawables.push_back(ptr);
-    return std::get<T>(*ptr);
-  }
-
-  Drawable::Rect& rect();
-  Drawable::Circle& circle();
-  Drawable::Ellipse& ellipse();
-  Drawable::Triangle& tri();
-  Drawable::Line& line();
+  // Lists for shapes queued from other threads, one per producer, see
+  // CommandList. Their shapes are drawn after the drawer's own, list by list
+  // in index order whatever order the producers finished in. Asking for an
+  // index past the last list creates the missing ones, do that before the
+  // producers start.
+  CommandList& commandList(size_t index);
 
   void draw();
+  void draw(Layer& layer);
+  // Draws the frames of several drawers on one device with a single submit.
+  // Drawers with a backend are drawn by draw() instead.
+  static void drawAll(std::span<Drawer* const> drawers);
+  // Draws the queued frame into a PPM image of any size, larger than any
+  // texture if need be, a tile of the drawer's size at a time. The default
+  // projection spans the whole image, one set with setTransformMatrix()
+  // maps the image instead. Each tile draws only the shapes whose bounds
+  // touch it and goes to the file once it is read back. Needs a headless
+  // drawer with an 8 bit RGBA or BGRA format. Composites, renderables, post
+  // chains, canvases and dynamic resolution do not apply and the frame is
+  // not recorded. Returns false when the image could not be written.
+  bool drawTiled(const std::string& path, uint32_t imageWidth,
+                 uint32_t imageHeight);
   void setTransformMatrix(glm::mat4 mat);
 
+  // Changes the size of the drawer's targets, e.g. after the surface was
+  // reconfigured for a resized window. The default projection follows the
+  // new size, one set with setTransformMatrix() is kept.
+  void resize(uint32_t width, uint32_t height);
+
+  inline uint32_t getWidth() {
+    return width;
+  }
+
+  inline uint32_t getHeight() {
+    return height;
+  }
+
+  // Layers share the drawer's projection, so a layer of the surface's size
+  // maps shapes 1:1. Their textures are recycled through the drawer's pool.
+  Layer createLayer();
+  Layer createLayer(uint32_t width, uint32_t height);
+  void releaseLayer(Layer& layer);
+
+  // Draws a layer over everything queued so far in the current frame.
+  void composite(const Layer& layer, float alpha = 1.0);
+  void composite(const Layer& layer, Rgba tint);
+
+  // Queues GPU-driven content for the current frame. The renderable must
+  // stay alive until the next draw() returns.
+  void add(Renderable& renderable);
+
+  // Writes every following frame into the recorder until called with
+  // nullptr. The recorder must outlive the recording.
+  void record(Recorder* recorder);
+
+  // Runs every following draw() frame through the chain on its way to the
+  // surface, until called with nullptr. Frames drawn into layers are left
+  // alone. The chain must outlive its use.
+  void setPostChain(PostChain* chain);
+
+  // Draws every following draw() frame into the canvas, until called with
+  // nullptr. Dynamic resolution is not applied to canvas frames. The canvas
+  // must outlive its use.
+  void setCanvas(Canvas* canvas);
+
+  // Texture a headless drawer renders into, null when drawing to a surface.
+  inline const wgpu::Texture& getTarget() {
+    return target;
+  }
+
+  inline TexturePool& getTexturePool() {
+    return resources->pool;
+  }
+
+  inline const std::shared_ptr<DrawerResources>& getResources() {
+    return resources;
+  }
+
+  // Renders into an internal target whose resolution follows the measured
+  // frame cost, then upscales it onto the surface in a final pass. The GPU
+  // part of the cost comes from timestamp queries when the device has
+  // TimestampQuery, otherwise from submit until the queue is done.
+  void enableDynamicResolution(float budgetMs = 16.6, float minScale = 0.5);
+  void disableDynamicResolution();
+
+  // Picks the segment count of circles and ellipses that have no res() of
+  // their own from their radius on screen, through the transform and model
+  // matrices, so that edges stay within maxError pixels of the curve. A
+  // maxError of zero or less uses the highest segment count.
+  void enableAdaptiveResolution(float maxError = 0.5);
+  void disableAdaptiveResolution();
+
+  inline float getResolutionScale() {
+    return dynamicResolution ? scaler.getScale() : 1.0;
+  }
+
+  inline double getFrameTime() {
+    return scaler.getFrameTime();
+  }
+
+  // A sample count of 1 renders straight into the surface, so LoadOp::Load
+  // only sees whatever the swapchain image held.
+  inline uint32_t getSampleCount() {
+    return sampleCount;
+  }
+
+  inline std::chrono::steady_clock::time_point getLastSubmitTime() {
+    return lastSubmit;
+  }
+
  private:
+  void init();
+  void createLayouts();
+  void createShapePipeline(DrawerResources::Pipelines& shared);
+  void compilePipeline(const wgpu::RenderPipelineDescriptor& desc,
+                       wgpu::RenderPipeline& result);
+  void usePipelines();
+  // Turns the queued shapes into the vertex and index arrays.
+  void buildGeometry();
+  void prepare();
+  void drawBackend();
+  // The shapes whose bounds on the image touch each tile, in queue order,
+  // tiles by row.
+  std::vector<std::vector<uint32_t>> binShapes(const glm::mat4& imageTransform,
+                                               uint32_t imageWidth,
+                                               uint32_t imageHeight,
+                                               uint32_t columns);
+  // Records a whole frame into the target, returning a scaled target that
+  // was replaced and can be released once the frame is submitted.
+  Layer encodeFrame(wgpu::CommandEncoder& encoder);
+  void finishFrame(Layer& retired,
+                   std::chrono::steady_clock::time_point start);
+  // A scissor limits rasterization to a region of the target.
+  void encodeShapes(wgpu::CommandEncoder& encoder, Layer& layer,
+                    const Region* scissor = nullptr);
+  void encodeShapes(wgpu::CommandEncoder& encoder, wgpu::TextureView target,
+                    wgpu::TextureView resolveTarget,
+                    const Region* scissor = nullptr);
+  void encodeBlit(wgpu::CommandEncoder& encoder, const Layer& source,
+                  wgpu::TextureView target);
+  void encodePost(wgpu::CommandEncoder& encoder, const Layer& scene,
+                  wgpu::TextureView target);
+  wgpu::BindGroup createLayerBindGroup(const wgpu::Texture& texture);
+  void syncCanvas();
+  void replayCanvas();
+  void resizeCanvas(Layer& previous);
+  void journalFrame();
+  Region damagedRegion();
+  void encodeCanvas(wgpu::CommandEncoder& encoder, wgpu::TextureView target);
+  void submit(wgpu::CommandEncoder& encoder);
+  void submitted();
+  Layer resizeScaledTarget();
+  // Bracket a frame's passes with timestamp writes when the device has
+  // TimestampQuery and no measurement is in flight.
+  void beginGpuTimer(wgpu::CommandEncoder& encoder);
+  void endGpuTimer(wgpu::CommandEncoder& encoder);
+  void trackGpuTime();
+  RenderContext context();
   void flushData();
+  void createBindGroup();
+  void createCompositePipelines(DrawerResources::Pipelines& shared);
+  void createTintBindGroup();
+
+  void mergeCommandLists();
+  // Calls f(buckets, base) for the drawer's own shapes and those of each
+  // merged command list, base being where they start in the queue.
+  template <typename F>
+  void forEachQueue(F&& f) {
+    f(shapes, 0u);
+    if (listsMerged) {
+      for (auto& list : commandLists) {
+        f(list->shapes, list->base);
+      }
+    }
+  }
 
-  void processRect(Drawable::Rect& r, uint32_t startIndex);
-  void processCircle(Drawable::Circle& c, uint32_t startIndex);
-  void processEllipse(Drawable::Ellipse& e, uint32_t startIndex);
-  void processTriangle(Drawable::Triangle& t, uint32_t startIndex);
-  void processLine(Drawable::Line& l, uint32_t startIndex);
+  void adaptResolution();
+  void tessellate();
+  // the built-in shapes queued so far, at their place in the queue
+  std::vector<std::optional<Drawable::Shape>> snapshotShapes();
+  void recordFrame(uint32_t layerWidth = 0, uint32_t layerHeight = 0);
+  void triangulatePolygons();
+  void cacheTriangulations();
 
+  // Returns true when the buffer had to be (re)created. Buffers grow to the
+  // next power of two, so geometry that changes size every frame keeps
+  // writing into the same buffer. The contents go through WriteBuffer from
+  // the tessellated vectors, which recording, tiled drawing and render
+  // backends read as well.
   template <typename T, wgpu::BufferUsage U>
-  void syncBuffer(wgpu::Buffer& buffer, const std::vector<T>& data) {
-    wgpu::Queue queue = device.GetQueue();
-    if (!buffer) {
-      buffer = Dusk::Builder::Buffer<T, U>()
-                   .data(data)
-                   .addUsage(wgpu::BufferUsage::CopyDst)
-                   .build(device);
-    } else if (buffer.GetSize() == sizeof(T) * data.size()) {
-      queue.WriteBuffer(buffer, 0, data.data(), sizeof(T) * data.size());
-    } else {
-      buffer.Destroy();
+  bool syncBuffer(wgpu::Buffer& buffer, const std::vector<T>& data) {
+    const uint64_t bytes = sizeof(T) * data.size();
+    const bool grow = !buffer || buffer.GetSize() < bytes;
+    if (grow) {
+      if (buffer) {
+        buffer.Destroy();
+      }
+      const size_t capacity = std::bit_ceil(std::max<size_t>(data.size(), 1));
       buffer = Dusk::Builder::Buffer<T, U>()
-                   .data(data)
+                   .size(capacity)
                    .addUsage(wgpu::BufferUsage::CopyDst)
                    .build(device);
     }
+    if (bytes > 0) {
+      device.GetQueue().WriteBuffer(buffer, 0, data.data(), bytes);
+    }
+    return grow;
   };
 
   wgpu::Device device;
@@ -87,18 +308,99 @@ class Drawer {
   wgpu::RenderPipeline pipeline;
   wgpu::TextureFormat format;
   wgpu::Texture tex;
+  wgpu::Texture target;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t sampleCount = 4;
+  std::shared_ptr<DrawerResources> resources;
+  std::shared_ptr<RenderBackend> backend;
+
+  // A layer composite or a renderable, drawn after the shapes queued
+  // before it.
+  struct Overlay {
+    wgpu::BindGroup bindGroup;
+    Rgba tint;
+    size_t drawable;
+    uint32_t firstIndex;
+    Renderable* renderable = nullptr;
+  };
+
+  // tints live 256 bytes apart to satisfy the dynamic offset alignment
+  static constexpr size_t tintStride = 256 / sizeof(glm::vec4);
+
+  std::vector<Overlay> overlays;
+  wgpu::RenderPipeline compositePipeline;
+  wgpu::RenderPipeline blitPipeline;
+  wgpu::Sampler sampler;
+  wgpu::BindGroupLayout layerLayout;
+  wgpu::BindGroupLayout tintLayout;
+  wgpu::Buffer tintBuffer;
+  wgpu::BindGroup tintBindGroup;
+
+  // One measurement in flight at a time, frames submitted meanwhile are not
+  // measured and the last result stands.
+  struct GpuTiming {
+    std::atomic<double> gpuMs{0};
+    std::atomic<bool> pending{false};
+    // keeps the slot alive for its callback, which may outlive the drawer
+    std::shared_ptr<GpuTiming> self;
+    // without timestamps, when the measured frame was submitted
+    std::chrono::steady_clock::time_point submitted;
+    wgpu::QuerySet querySet;
+    wgpu::Buffer resolve;
+    wgpu::Buffer readback;
+    // whether the frame being encoded writes timestamps
+    bool encoded = false;
+  };
+
+  bool dynamicResolution = false;
+  DynamicResolution scaler;
+  Layer scaledTarget;
+  PostChain* postChain = nullptr;
+  // what the shapes are drawn into before the post chain, unless that is
+  // the scaled target
+  Layer postScene;
+  Canvas* canvas = nullptr;
+  std::shared_ptr<GpuTiming> timing;
+  std::chrono::steady_clock::time_point lastSubmit;
 
   std::vector<float> vertices;
   std::vector<float> colors;
   std::vector<uint32_t> indices;
-  std::vector<std::shared_ptr<Drawable::Shape>> drawables;
+  std::vector<uint32_t> vertexModels;
+  // shared by copies like the resources
+  std::vector<std::shared_ptr<CommandList>> commandLists;
+  bool listsMerged = false;
+  // where each shape starts in the vertex and index arrays, plus the totals
+  std::vector<uint32_t> vertexOffsets;
+  std::vector<uint32_t> indexOffsets;
+
+  struct Triangulation {
+    Drawable::Polygon* polygon;
+    uint64_t hash;
+    std::vector<uint32_t> indices;
+  };
+
+  TriangulationCache triangulations;
+  // polygons that missed the cache this frame
+  std::vector<Triangulation> pendingTriangulations;
+
+  bool adaptiveResolution = false;
+  float maxCurveError = 0.5;
+  // CPU copy of the transform matrix
+  glm::mat4 transform{1};
 
   wgpu::Buffer vertexBuffer;
   wgpu::Buffer colorBuffer;
+  wgpu::Buffer modelIdBuffer;
   wgpu::Buffer indexBuffer;
   wgpu::Buffer transformBuffer;
+  wgpu::Buffer modelBuffer;
+  wgpu::BindGroupLayout bindGroupLayout;
   wgpu::BindGroup bindGroup;
 
+  Recorder* recorder = nullptr;
+
   Rgba m_clearColor = {0.0, 0.0, 0.0, 0.0};
   wgpu::LoadOp loadOp = wgpu::LoadOp::Load;
 };
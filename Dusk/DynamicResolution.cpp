@@ -0,0 +1,45 @@
+#include <Dusk/DynamicResolution.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace Dusk {
+
+// scale granularity
+static constexpr float STEP = 0.05;
+// weight of the newest sample in the moving average
+static constexpr double SMOOTHING = 0.1;
+// frames to wait after a change before adjusting again
+static constexpr uint32_t COOLDOWN = 15;
+// fraction of the budget under which the scale is raised
+static constexpr double HEADROOM = 0.75;
+
+DynamicResolution::DynamicResolution(float budgetMs, float minScale,
+                                     float maxScale)
+    : budgetMs(budgetMs), minScale(minScale), maxScale(maxScale) {}
+
+bool DynamicResolution::update(double frameMs) {
+  average = average == 0 ? frameMs : average + (frameMs - average) * SMOOTHING;
+  if (cooldown > 0) {
+    cooldown--;
+    return false;
+  }
+
+  float next = scale;
+  if (average > budgetMs) {
+    // the cost is roughly proportional to the pixel count
+    next = scale * std::sqrt(budgetMs / average);
+    next = std::min(std::round(next / STEP) * STEP, scale - STEP);
+  } else if (average < budgetMs * HEADROOM) {
+    next = std::round(scale / STEP) * STEP + STEP;
+  }
+  next = std::clamp(next, minScale, maxScale);
+
+  if (std::abs(next - scale) < STEP * 0.5f) {
+    return false;
+  }
+  scale = next;
+  cooldown = COOLDOWN;
+  return true;
+}
+
+}  // namespace Dusk
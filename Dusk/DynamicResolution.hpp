@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Dusk {
+
+// Picks a render scale that keeps the measured frame cost within a budget.
+// The scale is quantized to fixed steps so that the targets it sizes recur
+// and can be recycled by a TexturePool.
+class DynamicResolution {
+ public:
+  DynamicResolution() = default;
+  DynamicResolution(float budgetMs, float minScale = 0.5,
+                    float maxScale = 1.0);
+
+  // Feeds the cost of the last frame. Returns true if the scale changed.
+  bool update(double frameMs);
+
+  inline float getScale() {
+    return scale;
+  }
+
+  inline double getFrameTime() {
+    return average;
+  }
+
+  inline float getBudget() {
+    return budgetMs;
+  }
+
+ private:
+  float budgetMs = 16.6;
+  float minScale = 0.5;
+  float maxScale = 1.0;
+  float scale = 1.0;
+  double average = 0;
+  uint32_t cooldown = 0;
+};
+
+}  // namespace Dusk
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Dusk {
+
+struct Event {
+  enum class Type : uint8_t {
+    KeyPressed,
+    MouseMoved,
+    MousePressed,
+    MouseReleased
+  };
+
+  Type type;
+  // key for KeyPressed, button for MousePressed and MouseReleased
+  int code = 0;
+  double x = 0;
+  double y = 0;
+  // a mouse button was held during a MouseMoved
+  bool dragging = false;
+  // index of the window the event came from, 0 for the main window
+  uint32_t window = 0;
+  // number of moves folded into this one by coalescing
+  uint32_t merged = 0;
+  std::chrono::steady_clock::time_point time{};
+};
+
+// Lock-free ring buffer for exactly one producer and one consumer thread.
+template <typename T, size_t Capacity>
+class RingBuffer {
+  static_assert((Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+
+ public:
+  // Producer side. Fails when the buffer is full.
+  bool push(const T& item) {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) == Capacity) {
+      return false;
+    }
+    items[h & (Capacity - 1)] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Fails when the buffer is empty.
+  bool pop(T& item) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = items[t & (Capacity - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t size() const {
+    return head.load(std::memory_order_acquire) -
+           tail.load(std::memory_order_acquire);
+  }
+
+ private:
+  // kept on separate cache lines so producer and consumer do not contend
+  alignas(64) std::atomic<size_t> head{0};
+  alignas(64) std::atomic<size_t> tail{0};
+  std::array<T, Capacity> items;
+};
+
+// Timestamped input events pushed from the GLFW callbacks and drained by a
+// single consumer thread at a point of its choosing.
+class EventQueue {
+ public:
+  static constexpr size_t CAPACITY = 4096;
+
+  // Producer side, events that do not fit are counted and dropped.
+  inline void push(const Event& event) {
+    if (!ring.push(event)) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Consumer side. Pops every queued event and passes it to the handler.
+  // With coalescing, a run of moves in one window with the same drag state
+  // reaches the handler as its last move only. history() still holds every
+  // raw event.
+  template <typename F>
+  void drain(F&& handler) {
+    raw.clear();
+    Event e;
+    while (ring.pop(e)) {
+      raw.push_back(e);
+    }
+    for (size_t i = 0; i < raw.size(); i++) {
+      Event event = raw[i];
+      if (coalesce && event.type == Event::Type::MouseMoved) {
+        while (i + 1 < raw.size() &&
+               raw[i + 1].type == Event::Type::MouseMoved &&
+               raw[i + 1].dragging == event.dragging &&
+               raw[i + 1].window == event.window) {
+          uint32_t merged = event.merged + 1;
+          event = raw[++i];
+          event.merged = merged;
+        }
+      }
+      handler(event);
+    }
+  }
+
+  inline void setCoalesceMoves(bool coalesce) {
+    this->coalesce = coalesce;
+  }
+
+  // Raw events popped by the last drain(), in arrival order.
+  inline const std::vector<Event>& history() {
+    return raw;
+  }
+
+  inline size_t size() {
+    return ring.size();
+  }
+
+  inline uint64_t getDropped() {
+    return dropped.load(std::memory_order_relaxed);
+  }
+
+ private:
+  RingBuffer<Event, CAPACITY> ring;
+  std::vector<Event> raw;
+  std::atomic<uint64_t> dropped{0};
+  bool coalesce = true;
+};
+
+}  // namespace Dusk
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <Dusk/Triangulate.hpp>
 #include <cstdint>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
+#include <span>
 #include <tuple>
+#include <vector>
 
 template <typename T>
 struct always_false : std::false_type {};
@@ -220,6 +223,7 @@ class Resolution {
 
   Derived& res(uint32_t resolution) {
     this->resolution = resolution;
+    explicitRes = true;
     return static_cast<Derived&>(*this);
   }
 
@@ -227,8 +231,15 @@ class Resolution {
     return resolution;
   }
 
+  // false until res() is set, the drawer may then pick the resolution
+  // itself, see Drawer::enableAdaptiveResolution()
+  bool hasRes() {
+    return explicitRes;
+  }
+
  private:
   uint32_t resolution = 90;
+  bool explicitRes = false;
 };
 
 template <typename Derived>
@@ -368,6 +379,63 @@ class Thickness {
   float t;
 };
 
+template <typename Derived>
+class Path {
+ public:
+  virtual ~Path<Derived>() = default;
+
+  Derived& vertex(float x, float y) {
+    points.emplace_back(x, y);
+    return static_cast<Derived&>(*this);
+  }
+
+  Derived& vertex(glm::vec2 pos) {
+    points.push_back(pos);
+    return static_cast<Derived&>(*this);
+  }
+
+  Derived& vertices(std::span<const glm::vec2> pos) {
+    points.insert(points.end(), pos.begin(), pos.end());
+    return static_cast<Derived&>(*this);
+  }
+
+  // Curves continue from the last vertex and are flattened right away, so
+  // set the tolerance before adding them.
+  Derived& quadTo(glm::vec2 control, glm::vec2 pos) {
+    if (points.empty()) {
+      return vertex(pos);
+    }
+    flattenQuadratic(points, points.back(), control, pos, tol);
+    return static_cast<Derived&>(*this);
+  }
+
+  Derived& cubicTo(glm::vec2 control1, glm::vec2 control2, glm::vec2 pos) {
+    if (points.empty()) {
+      return vertex(pos);
+    }
+    flattenCubic(points, points.back(), control1, control2, pos, tol);
+    return static_cast<Derived&>(*this);
+  }
+
+  // maximum distance in pixels between a curve and its flattened outline
+  Derived& tolerance(float tolerance) {
+    tol = tolerance;
+    return static_cast<Derived&>(*this);
+  }
+
+  const std::vector<glm::vec2>& vertices() {
+    return points;
+  }
+
+  float tolerance() {
+    return tol;
+  }
+
+ private:
+  std::vector<glm::vec2> points;
+  float tol = 0.25;
+};
+
 }  // namespace Interface
 }  // namespace Drawable
 }  // namespace Dusk
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <cstdint>
+
+namespace Dusk {
+
+// An offscreen render target. Layers are created and released through a
+// Drawer, which takes their textures from its TexturePool. Shapes are drawn
+// into a layer with Drawer::draw(Layer&) and the layer is drawn onto the
+// current target with Drawer::composite().
+class Layer {
+ public:
+  inline uint32_t getWidth() const {
+    return texture ? texture.GetWidth() : 0;
+  }
+
+  inline uint32_t getHeight() const {
+    return texture ? texture.GetHeight() : 0;
+  }
+
+  inline const wgpu::Texture& getTexture() const {
+    return texture;
+  }
+
+  inline explicit operator bool() const {
+    return static_cast<bool>(texture);
+  }
+
+ private:
+  friend class Drawer;
+
+  // single sampled texture that gets sampled when compositing
+  wgpu::Texture texture;
+  // multisampled attachment which is resolved into texture
+  wgpu::Texture msaa;
+  wgpu::BindGroup bindGroup;
+};
+
+}  // namespace Dusk
@@ -0,0 +1,95 @@
+#include <Dusk/Log.hpp>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+namespace Dusk {
+namespace Log {
+
+namespace {
+
+// lines are written out once this much is buffered
+constexpr size_t FLUSH_SIZE = 4096;
+
+std::atomic<LogLevel> level{LogLevel::Info};
+std::mutex mutex;
+std::string buffer;
+
+const char* name(LogLevel level) {
+  switch (level) {
+    case LogLevel::Debug:
+      return "DEBUG";
+    case LogLevel::Info:
+      return "INFO";
+    case LogLevel::Success:
+      return "SUCCESS";
+    case LogLevel::Warning:
+      return "WARNING";
+    case LogLevel::Error:
+      return "ERROR";
+    case LogLevel::Off:
+      break;
+  }
+  return "";
+}
+
+void flushLocked() {
+  if (buffer.empty()) {
+    return;
+  }
+  std::cout.write(buffer.data(), buffer.size());
+  std::cout.flush();
+  buffer.clear();
+}
+
+// writes out whatever is left when the program exits
+struct FlushAtExit {
+  ~FlushAtExit() {
+    flush();
+  }
+} flushAtExit;
+
+}  // namespace
+
+void setLevel(LogLevel newLevel) {
+  level.store(newLevel, std::memory_order_relaxed);
+}
+
+LogLevel getLevel() {
+  return level.load(std::memory_order_relaxed);
+}
+
+void write(LogLevel lineLevel, std::string_view source,
+           std::string_view message) {
+  if (!enabled(lineLevel)) {
+    return;
+  }
+  std::lock_guard lock(mutex);
+  if (lineLevel == LogLevel::Error) {
+    // the lines before it go to stdout first, keeping errors in order
+    flushLocked();
+  }
+  buffer += '[';
+  buffer += name(lineLevel);
+  buffer += "] ";
+  buffer += source;
+  buffer += " - ";
+  buffer += message;
+  buffer += '\n';
+  if (lineLevel == LogLevel::Error) {
+    std::cerr.write(buffer.data(), buffer.size());
+    std::cerr.flush();
+    buffer.clear();
+  } else if (buffer.size() >= FLUSH_SIZE) {
+    flushLocked();
+  }
+}
+
+void flush() {
+  std::lock_guard lock(mutex);
+  flushLocked();
+}
+
+}  // namespace Log
+}  // namespace Dusk
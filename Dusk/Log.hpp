@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Dusk {
+
+enum class LogLevel : uint8_t { Debug, Info, Success, Warning, Error, Off };
+
+// Buffered, level filtered logging. Lines below the level are dropped
+// before they are formatted when written through DUSK_LOG. Errors are
+// written out immediately together with everything buffered before them,
+// other lines once the buffer fills up, on flush() or at exit.
+namespace Log {
+
+void setLevel(LogLevel level);
+LogLevel getLevel();
+void write(LogLevel level, std::string_view source, std::string_view message);
+void flush();
+
+inline bool enabled(LogLevel level) {
+  return level >= getLevel();
+}
+
+}  // namespace Log
+}  // namespace Dusk
+
+#define DUSK_LOG(level, source, msg)         \
+  do {                                       \
+    if (Dusk::Log::enabled(level)) {         \
+      Dusk::Log::write(level, source, msg);  \
+    }                                        \
+  } while (0)
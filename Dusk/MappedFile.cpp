@@ -0,0 +1,51 @@
+#include <Dusk/Log.hpp>
+#include <Dusk/MappedFile.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <format>
+
+namespace Dusk {
+
+MappedFile::MappedFile(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    DUSK_LOG(LogLevel::Error, "Dusk", std::format("Unable to open {}", path));
+    return;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    DUSK_LOG(LogLevel::Error, "Dusk", std::format("Unable to read {}", path));
+    close(fd);
+    return;
+  }
+  void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    DUSK_LOG(LogLevel::Error, "Dusk", std::format("Unable to map {}", path));
+    return;
+  }
+  madvise(map, st.st_size, MADV_SEQUENTIAL);
+  bytes = static_cast<const uint8_t*>(map);
+  length = st.st_size;
+}
+
+MappedFile::~MappedFile() {
+  if (bytes) {
+    munmap(const_cast<uint8_t*>(bytes), length);
+  }
+}
+
+void MappedFile::prefetch(size_t offset, size_t length) const {
+  if (!bytes || offset >= this->length) {
+    return;
+  }
+  static const size_t page = sysconf(_SC_PAGESIZE);
+  size_t start = offset / page * page;
+  size_t end = std::min(offset + length, this->length);
+  madvise(const_cast<uint8_t*>(bytes) + start, end - start, MADV_WILLNEED);
+}
+
+}  // namespace Dusk
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Dusk {
+
+// A read-only memory mapping of a whole file. Pages are read in by the
+// kernel on first access, so large files can be used before they are fully
+// resident.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Asks the kernel to start reading a range in the background.
+  void prefetch(size_t offset, size_t length) const;
+
+  inline const uint8_t* data() const {
+    return bytes;
+  }
+
+  inline size_t size() const {
+    return length;
+  }
+
+  inline explicit operator bool() const {
+    return bytes != nullptr;
+  }
+
+ private:
+  const uint8_t* bytes = nullptr;
+  size_t length = 0;
+};
+
+}  // namespace Dusk
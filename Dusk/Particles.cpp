@@ -0,0 +1,307 @@
+#include <Dusk/Particles.hpp>
+#include <Dusk/Shader.hpp>
+#include <algorithm>
+#include <string>
+
+namespace Dusk {
+
+// must match the Params and Particle structs of both shaders
+static constexpr const char* PARTICLE_TYPES = R"(
+    struct Emitter {
+        pos: vec2f,
+        radius: f32,
+        speed: f32,
+        color: vec4f
+    };
+
+    struct Attractor {
+        pos: vec2f,
+        strength: f32,
+        _pad: f32
+    };
+
+    struct Params {
+        gravity: vec2f,
+        dt: f32,
+        time: f32,
+        drag: f32,
+        lifetime: f32,
+        size: f32,
+        count: u32,
+        emitterCount: u32,
+        attractorCount: u32,
+        _pad: vec2u,
+        emitters: array<Emitter, 8>,
+        attractors: array<Attractor, 8>
+    };
+
+    struct Particle {
+        pos: vec2f,
+        vel: vec2f,
+        color: vec4f,
+        life: f32,
+        maxLife: f32,
+        _pad: vec2f
+    };
+)";
+
+static constexpr const char* PARTICLE_COMPUTE = R"(
+    @group(0) @binding(0) var<uniform> params: Params;
+    @group(0) @binding(1) var<storage, read_write> particles: array<Particle>;
+
+    fn hash(x: u32) -> u32 {
+        var h = x * 747796405u + 2891336453u;
+        h = ((h >> ((h >> 28u) + 4u)) ^ h) * 277803737u;
+        return (h >> 22u) ^ h;
+    }
+
+    fn rand(seed: ptr<function, u32>) -> f32 {
+        *seed = hash(*seed);
+        return f32(*seed) / 4294967295.0;
+    }
+
+    @compute @workgroup_size(64)
+    fn cs_main(@builtin(global_invocation_id) id: vec3u) {
+        let i = id.x;
+        if (i >= params.count) {
+            return;
+        }
+        var p = particles[i];
+        p.life -= params.dt;
+
+        if (p.life <= 0.0 && params.emitterCount > 0u) {
+            var seed = hash(i ^ hash(bitcast<u32>(params.time)));
+            let e = params.emitters[hash(seed) % params.emitterCount];
+            let a = rand(&seed) * 6.2831853;
+            let r = sqrt(rand(&seed)) * e.radius;
+            p.pos = e.pos + vec2f(cos(a), sin(a)) * r;
+            let dir = rand(&seed) * 6.2831853;
+            p.vel = vec2f(cos(dir), sin(dir)) * e.speed * rand(&seed);
+            p.color = e.color;
+            p.maxLife = params.lifetime * (0.25 + 0.75 * rand(&seed));
+            p.life = p.maxLife;
+        }
+
+        var force = params.gravity;
+        for (var j = 0u; j < params.attractorCount; j++) {
+            let att = params.attractors[j];
+            let d = att.pos - p.pos;
+            let dist2 = max(dot(d, d), 100.0);
+            force += d * (att.strength / (dist2 * sqrt(dist2)));
+        }
+        p.vel = (p.vel + force * params.dt) * max(1.0 - params.drag * params.dt, 0.0);
+        p.pos += p.vel * params.dt;
+        particles[i] = p;
+    }
+)";
+
+static constexpr const char* PARTICLE_RENDER = R"(
+    @group(0) @binding(0) var<uniform> transformMat: mat4x4f;
+    @group(0) @binding(1) var<uniform> params: Params;
+    @group(0) @binding(2) var<storage, read> particles: array<Particle>;
+
+    struct VertexOutput {
+        @builtin(position) pos: vec4f,
+        @location(0) uv: vec2f,
+        @location(1) col: vec4f
+    };
+
+    @vertex
+    fn vs_main(@builtin(vertex_index) v: u32,
+               @builtin(instance_index) i: u32) -> VertexOutput {
+        var out: VertexOutput;
+        let p = particles[i];
+        let corner = vec2f(f32(v & 1u), f32((v >> 1u) & 1u)) * 2.0 - 1.0;
+        let fade = clamp(p.life / max(p.maxLife, 1e-5), 0.0, 1.0);
+        out.pos = transformMat * vec4f(p.pos + corner * params.size * 0.5, 0.0, 1.0);
+        if (p.life <= 0.0) {
+            // outside the clip volume
+            out.pos = vec4f(2.0, 2.0, 2.0, 1.0);
+        }
+        out.uv = corner;
+        out.col = vec4f(p.color.rgb, p.color.a * fade);
+        return out;
+    }
+
+    @fragment
+    fn fs_main(in: VertexOutput) -> @location(0) vec4f {
+        let d = length(in.uv);
+        let mask = clamp((1.0 - d) / max(fwidth(d), 1e-5), 0.0, 1.0);
+        return vec4f(in.col.rgb, in.col.a * mask);
+    }
+)";
+
+// bytes per particle, see the Particle struct in the shaders
+static constexpr uint64_t PARTICLE_SIZE = 48;
+
+ParticleSystem::ParticleSystem(wgpu::Device& device, uint32_t count) {
+  params.count = count;
+
+  wgpu::BufferDescriptor desc{};
+  desc.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::Vertex |
+               wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::CopySrc;
+  desc.size = std::max<uint64_t>(count, 1) * PARTICLE_SIZE;
+  particles = device.CreateBuffer(&desc);
+
+  desc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+  desc.size = sizeof(Params);
+  paramBuffer = device.CreateBuffer(&desc);
+
+  start = std::chrono::steady_clock::now();
+  last = start;
+}
+
+ParticleSystem& ParticleSystem::gravity(glm::vec2 gravity) {
+  params.gravity = gravity;
+  return *this;
+}
+
+ParticleSystem& ParticleSystem::drag(float drag) {
+  params.drag = drag;
+  return *this;
+}
+
+ParticleSystem& ParticleSystem::lifetime(float seconds) {
+  params.lifetime = seconds;
+  return *this;
+}
+
+ParticleSystem& ParticleSystem::size(float size) {
+  params.size = size;
+  return *this;
+}
+
+ParticleSystem& ParticleSystem::addEmitter(const Emitter& emitter) {
+  if (params.emitterCount < MAX_EMITTERS) {
+    params.emitters[params.emitterCount++] = emitter;
+  }
+  return *this;
+}
+
+ParticleSystem& ParticleSystem::addAttractor(const Attractor& attractor) {
+  if (params.attractorCount < MAX_ATTRACTORS) {
+    params.attractors[params.attractorCount++] = attractor;
+  }
+  return *this;
+}
+
+ParticleSystem& ParticleSystem::clearEmitters() {
+  params.emitterCount = 0;
+  return *this;
+}
+
+ParticleSystem& ParticleSystem::clearAttractors() {
+  params.attractorCount = 0;
+  return *this;
+}
+
+Emitter& ParticleSystem::getEmitter(uint32_t i) {
+  return params.emitters[std::min(i, MAX_EMITTERS - 1)];
+}
+
+Attractor& ParticleSystem::getAttractor(uint32_t i) {
+  return params.attractors[std::min(i, MAX_ATTRACTORS - 1)];
+}
+
+void ParticleSystem::prepare(const RenderContext& context) {
+  if (!renderPipeline || !ctx.compatible(context)) {
+    createPipelines(context);
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  params.dt = std::chrono::duration<float>(now - last).count();
+  params.time = std::chrono::duration<float>(now - start).count();
+  last = now;
+  ctx.device.GetQueue().WriteBuffer(paramBuffer, 0, &params, sizeof(Params));
+}
+
+void ParticleSystem::encode(wgpu::CommandEncoder& encoder) {
+  wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+  pass.SetPipeline(computePipeline);
+  pass.SetBindGroup(0, computeBindGroup);
+  pass.DispatchWorkgroups((params.count + 63) / 64);
+  pass.End();
+}
+
+void ParticleSystem::render(wgpu::RenderPassEncoder& pass) {
+  pass.SetPipeline(renderPipeline);
+  pass.SetBindGroup(0, renderBindGroup);
+  pass.Draw(4, params.count);
+}
+
+void ParticleSystem::createPipelines(const RenderContext& context) {
+  ctx = context;
+  wgpu::Device& device = ctx.device;
+
+  std::string computeSource = std::string(PARTICLE_TYPES) + PARTICLE_COMPUTE;
+  Dusk::Shader compute =
+      Dusk::ShaderBuilder().source(computeSource.c_str()).build(device);
+
+  wgpu::ComputePipelineDescriptor computeDesc{};
+  computeDesc.compute.module = compute.mod;
+  computeDesc.compute.entryPoint = "cs_main";
+  computePipeline = device.CreateComputePipeline(&computeDesc);
+
+  wgpu::BindGroupEntry computeEntries[2];
+  computeEntries[0].binding = 0;
+  computeEntries[0].buffer = paramBuffer;
+  computeEntries[0].size = sizeof(Params);
+  computeEntries[1].binding = 1;
+  computeEntries[1].buffer = particles;
+  computeEntries[1].size = particles.GetSize();
+
+  wgpu::BindGroupDescriptor computeBindDesc{};
+  computeBindDesc.layout = computePipeline.GetBindGroupLayout(0);
+  computeBindDesc.entryCount = 2;
+  computeBindDesc.entries = computeEntries;
+  computeBindGroup = device.CreateBindGroup(&computeBindDesc);
+
+  std::string renderSource = std::string(PARTICLE_TYPES) + PARTICLE_RENDER;
+  Dusk::Shader shader =
+      Dusk::ShaderBuilder().source(renderSource.c_str()).build(device);
+
+  wgpu::BlendState blend;
+  blend.color.srcFactor = wgpu::BlendFactor::SrcAlpha;
+  blend.color.dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha;
+  blend.color.operation = wgpu::BlendOperation::Add;
+  blend.alpha.srcFactor = wgpu::BlendFactor::One;
+  blend.alpha.dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha;
+  blend.alpha.operation = wgpu::BlendOperation::Add;
+
+  wgpu::ColorTargetState colTarget;
+  colTarget.format = ctx.format;
+  colTarget.blend = &blend;
+  wgpu::FragmentState frag;
+  frag.module = shader.mod;
+  frag.entryPoint = "fs_main";
+  frag.targetCount = 1;
+  frag.targets = &colTarget;
+
+  wgpu::RenderPipelineDescriptor pipelineDesc;
+  pipelineDesc.vertex.module = shader.mod;
+  pipelineDesc.vertex.entryPoint = "vs_main";
+  pipelineDesc.primitive.topology = wgpu::PrimitiveTopology::TriangleStrip;
+  pipelineDesc.fragment = &frag;
+  pipelineDesc.multisample.count = ctx.sampleCount;
+  pipelineDesc.multisample.mask = ~0u;
+  renderPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+  wgpu::BindGroupEntry renderEntries[3];
+  renderEntries[0].binding = 0;
+  renderEntries[0].buffer = ctx.transformBuffer;
+  renderEntries[0].size = sizeof(float) * 16;
+  renderEntries[1].binding = 1;
+  renderEntries[1].buffer = paramBuffer;
+  renderEntries[1].size = sizeof(Params);
+  renderEntries[2].binding = 2;
+  renderEntries[2].buffer = particles;
+  renderEntries[2].size = particles.GetSize();
+
+  wgpu::BindGroupDescriptor renderBindDesc{};
+  renderBindDesc.layout = renderPipeline.GetBindGroupLayout(0);
+  renderBindDesc.entryCount = 3;
+  renderBindDesc.entries = renderEntries;
+  renderBindGroup = device.CreateBindGroup(&renderBindDesc);
+}
+
+}  // namespace Dusk
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/Renderable.hpp>
+#include <chrono>
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+namespace Dusk {
+
+// Particles are spawned here with a random direction and up to speed.
+struct Emitter {
+  glm::vec2 pos{0, 0};
+  float radius = 0;
+  float speed = 100;
+  glm::vec4 color{1, 1, 1, 1};
+};
+
+// Pulls particles towards pos, or pushes them away for negative strength.
+struct Attractor {
+  glm::vec2 pos{0, 0};
+  float strength = 0;
+  float _pad = 0;
+};
+
+// Particle state lives in a storage buffer that is simulated by a compute
+// pass and drawn as instanced quads straight from the same buffer, so it
+// never travels back to the CPU. Dead particles respawn at a random emitter.
+class ParticleSystem : public Renderable {
+ public:
+  static constexpr uint32_t MAX_EMITTERS = 8;
+  static constexpr uint32_t MAX_ATTRACTORS = 8;
+
+  ParticleSystem() = default;
+  ParticleSystem(wgpu::Device& device, uint32_t count);
+
+  ParticleSystem& gravity(glm::vec2 gravity);
+  ParticleSystem& drag(float drag);
+  ParticleSystem& lifetime(float seconds);
+  ParticleSystem& size(float size);
+  ParticleSystem& addEmitter(const Emitter& emitter);
+  ParticleSystem& addAttractor(const Attractor& attractor);
+  ParticleSystem& clearEmitters();
+  ParticleSystem& clearAttractors();
+
+  Emitter& getEmitter(uint32_t i);
+  Attractor& getAttractor(uint32_t i);
+
+  inline uint32_t getCount() {
+    return params.count;
+  }
+
+  inline wgpu::Buffer& getBuffer() {
+    return particles;
+  }
+
+  void prepare(const RenderContext& context) override;
+  void encode(wgpu::CommandEncoder& encoder) override;
+  void render(wgpu::RenderPassEncoder& pass) override;
+
+ private:
+  // mirrors the Params struct in the shaders
+  struct Params {
+    glm::vec2 gravity{0, 0};
+    float dt = 0;
+    float time = 0;
+    float drag = 0;
+    float lifetime = 2;
+    float size = 2;
+    uint32_t count = 0;
+    uint32_t emitterCount = 0;
+    uint32_t attractorCount = 0;
+    uint32_t _pad[2] = {0, 0};
+    Emitter emitters[MAX_EMITTERS];
+    Attractor attractors[MAX_ATTRACTORS];
+  };
+
+  void createPipelines(const RenderContext& context);
+
+  Params params;
+  RenderContext ctx{};
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point last;
+
+  wgpu::Buffer particles;
+  wgpu::Buffer paramBuffer;
+  wgpu::ComputePipeline computePipeline;
+  wgpu::RenderPipeline renderPipeline;
+  wgpu::BindGroup computeBindGroup;
+  wgpu::BindGroup renderBindGroup;
+};
+
+}  // namespace Dusk
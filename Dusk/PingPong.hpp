@@ -0,0 +1,73 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/Builder/Buffer.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Dusk {
+
+// Two equally sized storage buffers for simulations that read the last state
+// and write the next one. Build one bind group per parity with read(parity)
+// and write(parity), use the one for getParity() and swap() after each step.
+template <typename T>
+class PingPong {
+ public:
+  PingPong() = default;
+
+  PingPong(const wgpu::Device& device, uint64_t count,
+           wgpu::BufferUsage usage = wgpu::BufferUsage::Vertex) {
+    for (auto& buffer : buffers) {
+      buffer = Builder::StorageBuffer<T>()
+                   .size(count)
+                   .addUsage(usage | wgpu::BufferUsage::CopyDst |
+                             wgpu::BufferUsage::CopySrc)
+                   .build(device);
+    }
+  }
+
+  PingPong(const wgpu::Device& device, const std::vector<T>& initial,
+           wgpu::BufferUsage usage = wgpu::BufferUsage::Vertex) {
+    for (auto& buffer : buffers) {
+      buffer = Builder::StorageBuffer<T>()
+                   .data(initial)
+                   .addUsage(usage | wgpu::BufferUsage::CopyDst |
+                             wgpu::BufferUsage::CopySrc)
+                   .build(device);
+    }
+  }
+
+  // the buffer holding the latest state
+  inline wgpu::Buffer& front() {
+    return buffers[parity];
+  }
+
+  // the buffer the next step writes into
+  inline wgpu::Buffer& back() {
+    return buffers[parity ^ 1];
+  }
+
+  inline wgpu::Buffer& read(uint32_t parity) {
+    return buffers[parity & 1];
+  }
+
+  inline wgpu::Buffer& write(uint32_t parity) {
+    return buffers[(parity & 1) ^ 1];
+  }
+
+  inline uint32_t getParity() {
+    return parity;
+  }
+
+  inline void swap() {
+    parity ^= 1;
+  }
+
+ private:
+  wgpu::Buffer buffers[2];
+  uint32_t parity = 0;
+};
+
+}  // namespace Dusk
@@ -0,0 +1,119 @@
+#include <Dusk/Points.hpp>
+#include <algorithm>
+
+namespace Dusk {
+
+Points& Points::positions(std::span<const glm::vec2> positions) {
+  pointPositions = positions;
+  return *this;
+}
+
+Points& Points::sizes(std::span<const float> sizes) {
+  pointSizes = sizes;
+  return *this;
+}
+
+Points& Points::colors(std::span<const uint32_t> colors) {
+  pointColors = colors;
+  return *this;
+}
+
+Points& Points::size(float size) {
+  constantSize = size;
+  pointSizes = {};
+  return *this;
+}
+
+Points& Points::color(float r, float g, float b, float a) {
+  constantColor = rgba8({r, g, b, a});
+  pointColors = {};
+  return *this;
+}
+
+void Points::reserve(wgpu::Buffer& buffer, uint64_t size) {
+  size = std::max<uint64_t>(size, 4);
+  if (buffer && buffer.GetSize() >= size) {
+    return;
+  }
+  uint64_t capacity = buffer ? buffer.GetSize() : 4;
+  while (capacity < size) {
+    capacity *= 2;
+  }
+  if (buffer) {
+    buffer.Destroy();
+  }
+  wgpu::BufferDescriptor desc{};
+  desc.usage = wgpu::BufferUsage::Vertex | wgpu::BufferUsage::CopyDst;
+  desc.size = capacity;
+  buffer = ctx.device.CreateBuffer(&desc);
+}
+
+void Points::prepare(const RenderContext& context) {
+  if (!ctx.compatible(context)) {
+    if (ctx.device.Get() != context.device.Get()) {
+      positionBuffer = nullptr;
+      sizeBuffer = nullptr;
+      colorBuffer = nullptr;
+    }
+    ctx = context;
+    std::fill(std::begin(pipelines), std::end(pipelines), nullptr);
+  }
+
+  const bool perPointSize = pointSizes.size() > 1;
+  const bool perPointColor = pointColors.size() > 1;
+  // never read past the end of the shortest per point attribute
+  size_t count = pointPositions.size();
+  if (perPointSize) {
+    count = std::min(count, pointSizes.size());
+  }
+  if (perPointColor) {
+    count = std::min(count, pointColors.size());
+  }
+  drawCount = static_cast<uint32_t>(count);
+
+  variant = (perPointSize ? 1 : 0) | (perPointColor ? 2 : 0);
+  if (!pipelines[variant]) {
+    DotLayout layout;
+    layout.positionStride = sizeof(glm::vec2);
+    layout.sizeStride = perPointSize ? sizeof(float) : 0;
+    layout.colorStride = perPointColor ? sizeof(uint32_t) : 0;
+    pipelines[variant] = createDotPipeline(ctx, layout);
+    bindGroups[variant] = createDotBindGroup(ctx, pipelines[variant]);
+  }
+  if (count == 0) {
+    return;
+  }
+
+  wgpu::Queue queue = ctx.device.GetQueue();
+  reserve(positionBuffer, count * sizeof(glm::vec2));
+  queue.WriteBuffer(positionBuffer, 0, pointPositions.data(),
+                    count * sizeof(glm::vec2));
+
+  std::span<const float> sizes =
+      pointSizes.empty() ? std::span<const float>(&constantSize, 1)
+                         : pointSizes.first(perPointSize ? count : 1);
+  reserve(sizeBuffer, sizes.size_bytes());
+  queue.WriteBuffer(sizeBuffer, 0, sizes.data(), sizes.size_bytes());
+
+  std::span<const uint32_t> colors =
+      pointColors.empty() ? std::span<const uint32_t>(&constantColor, 1)
+                          : pointColors.first(perPointColor ? count : 1);
+  reserve(colorBuffer, colors.size_bytes());
+  queue.WriteBuffer(colorBuffer, 0, colors.data(), colors.size_bytes());
+}
+
+void Points::render(wgpu::RenderPassEncoder& pass) {
+  if (drawCount == 0) {
+    return;
+  }
+  // x and y are read from the same interleaved buffer
+  pass.SetPipeline(pipelines[variant]);
+  pass.SetBindGroup(0, bindGroups[variant]);
+  pass.SetVertexBuffer(0, positionBuffer);
+  pass.SetVertexBuffer(1, positionBuffer, sizeof(float));
+  pass.SetVertexBuffer(2, sizeBuffer);
+  pass.SetVertexBuffer(3, colorBuffer);
+  pass.Draw(4, drawCount);
+}
+
+}  // namespace Dusk
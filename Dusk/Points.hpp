@@ -0,0 +1,69 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/Dots.hpp>
+#include <Dusk/Renderable.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <span>
+
+namespace Dusk {
+
+// Scatter plot primitive for large numbers of points. Attributes are given
+// as spans which are uploaded with one WriteBuffer each in prepare(), so
+// they must stay valid until the drawer's next draw() returns. Points are
+// drawn as instanced quads with an analytic round mask instead of being
+// tessellated like circles.
+class Points : public Renderable {
+ public:
+  Points() = default;
+
+  Points& positions(std::span<const glm::vec2> positions);
+  // Diameters, either one per point or a single one for all of them.
+  Points& sizes(std::span<const float> sizes);
+  // RGBA8 colors, see rgba8(), either one per point or one for all of them.
+  Points& colors(std::span<const uint32_t> colors);
+  Points& size(float size);
+  Points& color(float r, float g, float b, float a = 1.0);
+
+  static inline uint32_t rgba8(glm::vec4 color) {
+    auto channel = [](float v) {
+      return static_cast<uint32_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+    };
+    return channel(color.r) | channel(color.g) << 8 | channel(color.b) << 16 |
+           channel(color.a) << 24;
+  }
+
+  inline uint32_t getCount() {
+    return static_cast<uint32_t>(pointPositions.size());
+  }
+
+  void prepare(const RenderContext& context) override;
+  void render(wgpu::RenderPassEncoder& pass) override;
+
+ private:
+  // grows buffer to hold at least size bytes, doubling to avoid reallocating
+  // every frame while the point count creeps up
+  void reserve(wgpu::Buffer& buffer, uint64_t size);
+
+  std::span<const glm::vec2> pointPositions;
+  std::span<const float> pointSizes;
+  std::span<const uint32_t> pointColors;
+  float constantSize = 2;
+  uint32_t constantColor = 0xffffffff;
+
+  RenderContext ctx{};
+  // indexed by whether sizes and colors are given per point
+  wgpu::RenderPipeline pipelines[4];
+  wgpu::BindGroup bindGroups[4];
+  wgpu::Buffer positionBuffer;
+  wgpu::Buffer sizeBuffer;
+  wgpu::Buffer colorBuffer;
+  uint32_t variant = 0;
+  uint32_t drawCount = 0;
+};
+
+}  // namespace Dusk
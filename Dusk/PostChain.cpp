@@ -0,0 +1,426 @@
+#include <Dusk/Builder/BindGroup.hpp>
+#include <Dusk/Builder/ComputePipeline.hpp>
+#include <Dusk/PostChain.hpp>
+#include <Dusk/Shader.hpp>
+#include <algorithm>
+#include <format>
+
+namespace Dusk {
+
+namespace {
+
+constexpr uint32_t PIXEL_GROUP = 8;
+constexpr uint32_t LINE_GROUP = 128;
+
+std::string header() {
+  return std::format(R"(
+    struct Params {{
+        size: vec2u,
+        time: f32,
+        values: array<vec4f, {}>
+    }};
+
+    @group(0) @binding(0) var src: texture_2d<f32>;
+    @group(0) @binding(1) var other: texture_2d<f32>;
+    @group(0) @binding(2) var dst: texture_storage_2d<rgba16float, write>;
+    @group(0) @binding(3) var<uniform> params: Params;
+    @group(0) @binding(4) var linearSampler: sampler;
+  )",
+                     PostChain::MAX_FUSED);
+}
+
+// body runs once per pixel with `color` loaded from src
+std::string pointwiseShader(const std::string& body) {
+  return header() + R"(
+    @compute @workgroup_size(8, 8)
+    fn main(@builtin(global_invocation_id) id: vec3u) {
+        if (any(id.xy >= params.size)) {
+            return;
+        }
+        let texel = vec2i(id.xy);
+        let uv = (vec2f(id.xy) + 0.5) / vec2f(params.size);
+        var color = textureLoad(src, texel, 0);
+)" + body + R"(
+        textureStore(dst, texel, color);
+    }
+  )";
+}
+
+// function is the user's `fn effect(texel, uv, value) -> vec4f`
+std::string texelShader(const std::string& function) {
+  return header() + function + R"(
+    @compute @workgroup_size(8, 8)
+    fn main(@builtin(global_invocation_id) id: vec3u) {
+        if (any(id.xy >= params.size)) {
+            return;
+        }
+        let texel = vec2i(id.xy);
+        let uv = (vec2f(id.xy) + 0.5) / vec2f(params.size);
+        textureStore(dst, texel, effect(texel, uv, params.values[0]));
+    }
+  )";
+}
+
+// One direction of a separable gaussian. Each workgroup covers 128 pixels of
+// a row or column and loads them once into workgroup memory, together with
+// the pixels the kernel reaches past either end.
+std::string blurShader(bool rows) {
+  return header() + std::format(R"(
+    const TILE = {0}i;
+    const RADIUS = {1}i;
+    var<workgroup> tile: array<vec4f, {2}>;
+
+    @compute @workgroup_size({3}, {4})
+    fn main(@builtin(workgroup_id) group: vec3u,
+            @builtin(local_invocation_index) local: u32) {{
+        let dir = vec2i({3} / TILE, {4} / TILE);
+        let size = vec2i(params.size);
+        let first = vec2i(group.xy) * vec2i({3}, {4});
+        for (var i = i32(local); i < TILE + 2 * RADIUS; i += TILE) {{
+            let p = clamp(first + dir * (i - RADIUS), vec2i(0), size - 1);
+            tile[i] = textureLoad(src, p, 0);
+        }}
+        workgroupBarrier();
+
+        let texel = first + dir * i32(local);
+        if (any(texel >= size)) {{
+            return;
+        }}
+        let radius = clamp(i32(params.values[0].y), 0, RADIUS);
+        let sigma = max(f32(radius) * 0.5, 0.5);
+        var sum = vec4f(0.0);
+        var total = 0.0;
+        for (var k = -radius; k <= radius; k++) {{
+            let w = exp(-f32(k * k) / (2.0 * sigma * sigma));
+            sum += tile[i32(local) + RADIUS + k] * w;
+            total += w;
+        }}
+        textureStore(dst, texel, sum / total);
+    }}
+  )",
+                                LINE_GROUP, PostChain::MAX_BLUR_RADIUS,
+                                LINE_GROUP + 2 * PostChain::MAX_BLUR_RADIUS,
+                                rows ? LINE_GROUP : 1, rows ? 1 : LINE_GROUP);
+}
+
+const char* BRIGHT_PASS = R"(
+        let luminance = dot(color.rgb, vec3f(0.2126, 0.7152, 0.0722));
+        color = vec4f(color.rgb * smoothstep(value.x, value.x + 0.1, luminance),
+                      1.0);)";
+
+const char* BLOOM_COMBINE = R"(
+    fn effect(texel: vec2i, uv: vec2f, value: vec4f) -> vec4f {
+        let base = textureLoad(other, texel, 0);
+        let glow = textureLoad(src, texel, 0).rgb * value.z;
+        return vec4f(base.rgb + glow, base.a);
+    }
+  )";
+
+uint32_t groups(uint32_t size, uint32_t group) {
+  return (size + group - 1) / group;
+}
+
+}  // namespace
+
+PostChain::PostChain() : start(std::chrono::steady_clock::now()) {}
+
+PostChain& PostChain::add(Kind kind, const std::string& wgsl,
+                          glm::vec4 value) {
+  effects.push_back({kind, wgsl, value});
+  dirty = true;
+  return *this;
+}
+
+PostChain& PostChain::pointwise(const std::string& wgsl, glm::vec4 value) {
+  return add(Kind::Pointwise, wgsl, value);
+}
+
+PostChain& PostChain::pass(const std::string& wgsl, glm::vec4 value) {
+  return add(Kind::Texel, wgsl, value);
+}
+
+PostChain& PostChain::grade(float exposure, float contrast, float saturation) {
+  return pointwise(R"(
+        var graded = color.rgb * exp2(value.x);
+        graded = (graded - 0.5) * value.y + 0.5;
+        let luminance = dot(graded, vec3f(0.2126, 0.7152, 0.0722));
+        color = vec4f(mix(vec3f(luminance), graded, value.z), color.a);)",
+                   {exposure, contrast, saturation, 0});
+}
+
+PostChain& PostChain::vignette(float strength) {
+  return pointwise(R"(
+        let d = uv - 0.5;
+        color = vec4f(color.rgb * max(1.0 - value.x * dot(d, d) * 2.0, 0.0),
+                      color.a);)",
+                   {strength, 0, 0, 0});
+}
+
+PostChain& PostChain::blur(float radius) {
+  return add(Kind::Blur, "", {0, radius, 0, 0});
+}
+
+PostChain& PostChain::bloom(float threshold, float radius, float intensity) {
+  return add(Kind::Bloom, "", {threshold, radius, intensity, 0});
+}
+
+PostChain& PostChain::feedback(float decay, const std::string& displacement) {
+  return add(Kind::Feedback, std::format(R"(
+    fn effect(texel: vec2i, uv: vec2f, value: vec4f) -> vec4f {{
+        let time = params.time;
+        let offset = {};
+        let trail = textureSampleLevel(other, linearSampler, uv + offset, 0.0);
+        return max(textureLoad(src, texel, 0), trail * value.x);
+    }}
+  )",
+                                         displacement),
+             {decay, 0, 0, 0});
+}
+
+PostChain& PostChain::set(size_t effect, glm::vec4 value) {
+  if (effect < effects.size()) {
+    effects[effect].value = value;
+  }
+  return *this;
+}
+
+void PostChain::clear() {
+  effects.clear();
+  dirty = true;
+}
+
+wgpu::ComputePipeline PostChain::pipeline(const std::string& source) {
+  Dusk::Shader shader =
+      Dusk::ShaderBuilder().source(source.c_str()).build(device);
+  return Builder::ComputePipeline()
+      .shader(shader)
+      .entryPoint("main")
+      .layout(pipelineLayout)
+      .build(device);
+}
+
+void PostChain::build(wgpu::Device& device) {
+  if (this->device.Get() != device.Get()) {
+    this->device = device;
+    paramBuffer = nullptr;
+
+    wgpu::BindGroupLayoutEntry entries[5];
+    for (uint32_t i = 0; i < 5; i++) {
+      entries[i].binding = i;
+      entries[i].visibility = wgpu::ShaderStage::Compute;
+    }
+    entries[0].texture.sampleType = wgpu::TextureSampleType::Float;
+    entries[0].texture.viewDimension = wgpu::TextureViewDimension::e2D;
+    entries[1].texture.sampleType = wgpu::TextureSampleType::Float;
+    entries[1].texture.viewDimension = wgpu::TextureViewDimension::e2D;
+    entries[2].storageTexture.access = wgpu::StorageTextureAccess::WriteOnly;
+    entries[2].storageTexture.format = wgpu::TextureFormat::RGBA16Float;
+    entries[2].storageTexture.viewDimension = wgpu::TextureViewDimension::e2D;
+    entries[3].buffer.type = wgpu::BufferBindingType::Uniform;
+    entries[3].buffer.minBindingSize = sizeof(Params);
+    entries[4].sampler.type = wgpu::SamplerBindingType::Filtering;
+
+    wgpu::BindGroupLayoutDescriptor layoutDesc{};
+    layoutDesc.entryCount = 5;
+    layoutDesc.entries = entries;
+    layout = device.CreateBindGroupLayout(&layoutDesc);
+
+    wgpu::PipelineLayoutDescriptor pipelineLayoutDesc{};
+    pipelineLayoutDesc.bindGroupLayoutCount = 1;
+    pipelineLayoutDesc.bindGroupLayouts = &layout;
+    pipelineLayout = device.CreatePipelineLayout(&pipelineLayoutDesc);
+
+    wgpu::SamplerDescriptor samplerDesc{};
+    samplerDesc.magFilter = wgpu::FilterMode::Linear;
+    samplerDesc.minFilter = wgpu::FilterMode::Linear;
+    sampler = device.CreateSampler(&samplerDesc);
+  }
+
+  wgpu::ComputePipeline rowBlur;
+  wgpu::ComputePipeline columnBlur;
+  auto blurPasses = [&](size_t effect) {
+    if (!rowBlur) {
+      rowBlur = pipeline(blurShader(true));
+      columnBlur = pipeline(blurShader(false));
+    }
+    passes.push_back({rowBlur, Dispatch::Rows, Other::Input, {effect}});
+    passes.push_back({columnBlur, Dispatch::Columns, Other::Input, {effect}});
+  };
+
+  passes.clear();
+  for (size_t i = 0; i < effects.size(); i++) {
+    const Effect& effect = effects[i];
+    switch (effect.kind) {
+      case Kind::Pointwise: {
+        // fuse with the pointwise effects right after it
+        Pass pass;
+        std::string body;
+        for (; i < effects.size() && effects[i].kind == Kind::Pointwise &&
+               pass.effects.size() < MAX_FUSED;
+             i++) {
+          body += std::format(
+              "        {{\n        let value = params.values[{}];{}\n        "
+              "}}\n",
+              pass.effects.size(), effects[i].wgsl);
+          pass.effects.push_back(i);
+        }
+        i--;
+        pass.pipeline = pipeline(pointwiseShader(body));
+        passes.push_back(pass);
+        break;
+      }
+      case Kind::Texel:
+        passes.push_back(
+            {pipeline(texelShader(effect.wgsl)), Dispatch::Pixels,
+             Other::Input, {i}});
+        break;
+      case Kind::Blur:
+        blurPasses(i);
+        break;
+      case Kind::Bloom:
+        passes.push_back({pipeline(pointwiseShader(std::format(
+                              "        {{\n        let value = "
+                              "params.values[0];{}\n        }}\n",
+                              BRIGHT_PASS))),
+                          Dispatch::Pixels, Other::Input, {i}, true});
+        blurPasses(i);
+        passes.push_back({pipeline(texelShader(BLOOM_COMBINE)),
+                          Dispatch::Pixels, Other::Base, {i}});
+        break;
+      case Kind::Feedback:
+        passes.push_back({pipeline(texelShader(effect.wgsl)),
+                          Dispatch::Pixels, Other::History, {i}, false, true});
+        break;
+    }
+  }
+  dirty = false;
+}
+
+void PostChain::release(TexturePool& pool, wgpu::Texture& texture) {
+  if (texture) {
+    pool.release(texture);
+    texture = nullptr;
+  }
+}
+
+wgpu::Texture PostChain::encode(wgpu::CommandEncoder& encoder,
+                                wgpu::Device& device, TexturePool& pool,
+                                const wgpu::Texture& scene) {
+  if (dirty || this->device.Get() != device.Get()) {
+    build(device);
+  }
+  this->scene = scene;
+  output = scene;
+  if (passes.empty()) {
+    return output;
+  }
+
+  const uint32_t width = scene.GetWidth();
+  const uint32_t height = scene.GetHeight();
+  if (history &&
+      (history.GetWidth() != width || history.GetHeight() != height)) {
+    release(pool, history);
+  }
+
+  // one block of values per pass, all written with a single upload
+  std::chrono::duration<float> time = std::chrono::steady_clock::now() - start;
+  params.resize(passes.size());
+  for (size_t i = 0; i < passes.size(); i++) {
+    Params& p = params[i];
+    p = {width, height, time.count(), 0, {}};
+    for (size_t j = 0; j < passes[i].effects.size(); j++) {
+      p.values[j] = effects[passes[i].effects[j]].value;
+    }
+  }
+  const uint64_t bytes = params.size() * sizeof(Params);
+  if (!paramBuffer || paramBuffer.GetSize() < bytes) {
+    if (paramBuffer) {
+      paramBuffer.Destroy();
+    }
+    wgpu::BufferDescriptor bufferDesc{};
+    bufferDesc.size = bytes;
+    bufferDesc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+    paramBuffer = device.CreateBuffer(&bufferDesc);
+  }
+  device.GetQueue().WriteBuffer(paramBuffer, 0, params.data(), bytes);
+
+  // every dispatch is its own usage scope, so each pass sees the writes of
+  // the one before it
+  wgpu::ComputePassEncoder computePass = encoder.BeginComputePass();
+  wgpu::Texture current = scene;
+  wgpu::Texture base;
+  for (size_t i = 0; i < passes.size(); i++) {
+    Pass& pass = passes[i];
+    if (pass.saveBase) {
+      base = current;
+    }
+    wgpu::Texture other = current;
+    if (pass.other == Other::Base) {
+      other = base;
+    } else if (pass.other == Other::History && history) {
+      other = history;
+    }
+
+    wgpu::Texture out = pool.acquire(
+        {width, height, wgpu::TextureFormat::RGBA16Float, 1,
+         wgpu::TextureUsage::StorageBinding |
+             wgpu::TextureUsage::TextureBinding});
+    wgpu::BindGroup bindGroup =
+        Builder::BindGroup()
+            .layout(layout)
+            .texture(0, current.CreateView())
+            .texture(1, other.CreateView())
+            .texture(2, out.CreateView())
+            .buffer(3, paramBuffer, i * sizeof(Params), sizeof(Params))
+            .sampler(4, sampler)
+            .build(device);
+
+    computePass.SetPipeline(pass.pipeline);
+    computePass.SetBindGroup(0, bindGroup);
+    switch (pass.dispatch) {
+      case Dispatch::Pixels:
+        computePass.DispatchWorkgroups(groups(width, PIXEL_GROUP),
+                                       groups(height, PIXEL_GROUP));
+        break;
+      case Dispatch::Rows:
+        computePass.DispatchWorkgroups(groups(width, LINE_GROUP), height);
+        break;
+      case Dispatch::Columns:
+        computePass.DispatchWorkgroups(width, groups(height, LINE_GROUP));
+        break;
+    }
+
+    // Released textures may be handed out again within this pass, which is
+    // safe since later dispatches run after this one.
+    wgpu::Texture input = current;
+    current = out;
+    if (pass.keepHistory) {
+      release(pool, history);
+      history = out;
+    }
+    if (pass.other == Other::Base) {
+      if (base.Get() != scene.Get()) {
+        release(pool, base);
+      }
+      base = nullptr;
+    }
+    if (input.Get() != scene.Get() && input.Get() != base.Get() &&
+        input.Get() != history.Get()) {
+      release(pool, input);
+    }
+  }
+  computePass.End();
+
+  output = current;
+  return output;
+}
+
+void PostChain::finish(TexturePool& pool) {
+  if (output.Get() != scene.Get() && output.Get() != history.Get()) {
+    release(pool, output);
+  }
+  output = nullptr;
+  scene = nullptr;
+}
+
+}  // namespace Dusk
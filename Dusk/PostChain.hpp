@@ -0,0 +1,128 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/TexturePool.hpp>
+#include <chrono>
+#include <cstdint>
+#include <glm/vec4.hpp>
+#include <string>
+#include <vector>
+
+namespace Dusk {
+
+// Effects applied to a drawer's frame before it reaches the surface, see
+// Drawer::setPostChain(). Every effect is a compute dispatch over pooled
+// rgba16float textures, all of them recorded into one compute pass of the
+// frame's command encoder. Consecutive pointwise effects are fused into a
+// single dispatch.
+//
+// Each effect has a vec4 value that can be changed with set() without
+// rebuilding the chain. Effects are numbered in the order they were added.
+class PostChain {
+ public:
+  // most effects fused into one dispatch
+  static constexpr uint32_t MAX_FUSED = 14;
+  // blur radii are clamped to this many pixels
+  static constexpr uint32_t MAX_BLUR_RADIUS = 32;
+
+  PostChain();
+
+  // WGSL statements that modify `color: vec4f`, with `uv: vec2f`,
+  // `texel: vec2i`, `value: vec4f` and `params.time` in scope.
+  PostChain& pointwise(const std::string& wgsl, glm::vec4 value = {});
+  // A WGSL function `fn effect(texel: vec2i, uv: vec2f, value: vec4f) ->
+  // vec4f` computing each output pixel, which may read anywhere from `src`
+  // with textureLoad() or textureSampleLevel() and `linearSampler`.
+  PostChain& pass(const std::string& wgsl, glm::vec4 value = {});
+
+  // Exposure in stops, then contrast and saturation around 1.
+  PostChain& grade(float exposure, float contrast = 1, float saturation = 1);
+  // Darkens the corners by strength.
+  PostChain& vignette(float strength);
+  // Separable gaussian blur.
+  PostChain& blur(float radius);
+  // Adds a blurred copy of everything brighter than threshold.
+  PostChain& bloom(float threshold, float radius, float intensity = 1);
+  // Keeps a trail of previous frames that fades by decay per frame. The
+  // trail is sampled displaced by a WGSL expression in `uv` and `time`
+  // giving an offset in uv units.
+  PostChain& feedback(float decay,
+                      const std::string& displacement = "vec2f(0.0)");
+
+  PostChain& set(size_t effect, glm::vec4 value);
+  void clear();
+
+  inline size_t getEffectCount() {
+    return effects.size();
+  }
+
+  // Records the chain over scene and returns the texture holding the
+  // result, which stays valid until finish().
+  wgpu::Texture encode(wgpu::CommandEncoder& encoder, wgpu::Device& device,
+                       TexturePool& pool, const wgpu::Texture& scene);
+  // Returns the textures of the last encode() to the pool.
+  void finish(TexturePool& pool);
+
+ private:
+  enum class Kind { Pointwise, Texel, Blur, Bloom, Feedback };
+
+  struct Effect {
+    Kind kind;
+    std::string wgsl;
+    glm::vec4 value;
+  };
+
+  enum class Dispatch { Pixels, Rows, Columns };
+  // what a pass reads besides its input
+  enum class Other { Input, Base, History };
+
+  struct Pass {
+    wgpu::ComputePipeline pipeline;
+    Dispatch dispatch = Dispatch::Pixels;
+    Other other = Other::Input;
+    // effects whose values the pass sees, in order
+    std::vector<size_t> effects;
+    // keep the input for a later pass reading Other::Base
+    bool saveBase = false;
+    // the output becomes the history of the next frame
+    bool keepHistory = false;
+  };
+
+  // uniform offsets have to be aligned to 256 bytes
+  static constexpr uint64_t PARAMS_STRIDE = 256;
+
+  // matches Params in the shaders, padded to the offset alignment
+  struct alignas(PARAMS_STRIDE) Params {
+    uint32_t width;
+    uint32_t height;
+    float time;
+    float _pad;
+    glm::vec4 values[MAX_FUSED];
+  };
+
+  static_assert(sizeof(Params) == PARAMS_STRIDE);
+
+  PostChain& add(Kind kind, const std::string& wgsl, glm::vec4 value);
+  void build(wgpu::Device& device);
+  wgpu::ComputePipeline pipeline(const std::string& source);
+  void release(TexturePool& pool, wgpu::Texture& texture);
+
+  std::vector<Effect> effects;
+  std::vector<Pass> passes;
+  bool dirty = true;
+
+  wgpu::Device device;
+  wgpu::BindGroupLayout layout;
+  wgpu::PipelineLayout pipelineLayout;
+  wgpu::Sampler sampler;
+  wgpu::Buffer paramBuffer;
+  std::vector<Params> params;
+
+  wgpu::Texture scene;
+  wgpu::Texture output;
+  wgpu::Texture history;
+  std::chrono::steady_clock::time_point start;
+};
+
+}  // namespace Dusk
@@ -0,0 +1,376 @@
+#include <Dusk/Drawer.hpp>
+#include <Dusk/Log.hpp>
+#include <Dusk/Recording.hpp>
+#include <algorithm>
+#include <bit>
+#include <format>
+
+namespace Dusk {
+
+namespace {
+
+using Recording::Fields;
+
+template <typename T, size_t I = 0>
+constexpr size_t shapeIndex() {
+  if constexpr (std::is_same_v<T,
+                               std::variant_alternative_t<I, Drawable::Shape>>) {
+    return I;
+  } else {
+    return shapeIndex<T, I + 1>();
+  }
+}
+
+// Flattens the fields of a shape, returning how many there are. Polygon
+// outlines are written separately.
+size_t pack(Drawable::Shape& shape, Fields& fields) {
+  size_t n = 0;
+  auto put = [&](float value) { fields[n++] = std::bit_cast<uint32_t>(value); };
+  auto put3 = [&](glm::vec3 value) {
+    put(value.x);
+    put(value.y);
+    put(value.z);
+  };
+
+  std::visit(
+      [&](auto& s) {
+        using T = std::decay_t<decltype(s)>;
+        if constexpr (std::is_same_v<T, Drawable::Rect>) {
+          put3(s.xyz());
+          put(s.w());
+          put(s.h());
+        } else if constexpr (std::is_same_v<T, Drawable::Circle>) {
+          put3(s.xyz());
+          put(s.radius());
+          fields[n++] = s.res();
+        } else if constexpr (std::is_same_v<T, Drawable::Ellipse>) {
+          put3(s.xyz());
+          put(s.w());
+          put(s.h());
+          fields[n++] = s.res();
+        } else if constexpr (std::is_same_v<T, Drawable::Triangle>) {
+          put3(s.template p1<glm::vec3>());
+          put3(s.template p2<glm::vec3>());
+          put3(s.template p3<glm::vec3>());
+        } else if constexpr (std::is_same_v<T, Drawable::Line>) {
+          put3(s.template p1<glm::vec3>());
+          put3(s.template p2<glm::vec3>());
+          put(s.thickness());
+        }
+        glm::vec4 color = s.rgba();
+        put(color.r);
+        put(color.g);
+        put(color.b);
+        put(color.a);
+      },
+      shape);
+  return n;
+}
+
+// Queues a shape on the drawer from fields written by pack().
+void unpack(size_t type, const Fields& fields,
+            const std::vector<glm::vec2>& outline, Drawer& drawer) {
+  size_t n = 0;
+  auto get = [&]() { return std::bit_cast<float>(fields[n++]); };
+  auto get3 = [&]() {
+    glm::vec3 value;
+    value.x = get();
+    value.y = get();
+    value.z = get();
+    return value;
+  };
+  auto color = [&](auto& s) {
+    glm::vec4 value;
+    value.r = get();
+    value.g = get();
+    value.b = get();
+    value.a = get();
+    s.rgba(value.r, value.g, value.b, value.a);
+  };
+
+  switch (type) {
+    case shapeIndex<Drawable::Rect>(): {
+      auto& r = drawer.rect().xyz(get3());
+      float w = get();
+      r.wh(w, get());
+      color(r);
+      break;
+    }
+    case shapeIndex<Drawable::Circle>(): {
+      auto& c = drawer.circle().xyz(get3());
+      c.radius(get()).res(fields[n++]);
+      color(c);
+      break;
+    }
+    case shapeIndex<Drawable::Ellipse>(): {
+      auto& e = drawer.ellipse().xyz(get3());
+      float w = get();
+      e.wh(w, get()).res(fields[n++]);
+      color(e);
+      break;
+    }
+    case shapeIndex<Drawable::Triangle>(): {
+      auto& t = drawer.tri().p1(get3());
+      t.p2(get3()).p3(get3());
+      color(t);
+      break;
+    }
+    case shapeIndex<Drawable::Line>(): {
+      auto& l = drawer.line().p1(get3());
+      l.p2(get3()).thickness(get());
+      color(l);
+      break;
+    }
+    case shapeIndex<Drawable::Polygon>(): {
+      color(drawer.polygon().vertices(outline));
+      break;
+    }
+  }
+}
+
+}  // namespace
+
+Recorder::Recorder(const std::string& path) {
+  file = std::fopen(path.c_str(), "wb");
+  if (!file) {
+    DUSK_LOG(LogLevel::Error, "Dusk",
+             std::format("Unable to open recording {}", path));
+    return;
+  }
+  write(Recording::MAGIC);
+  write(Recording::VERSION);
+  flush();
+}
+
+Recorder::~Recorder() {
+  close();
+}
+
+void Recorder::clear(float r, float g, float b, float a) {
+  if (!file) {
+    return;
+  }
+  write(Recording::Op::Clear);
+  write(std::array<float, 4>{r, g, b, a});
+}
+
+void Recorder::transform(const glm::mat4& mat) {
+  if (!file) {
+    return;
+  }
+  write(Recording::Op::Transform);
+  write(mat);
+}
+
+void Recorder::frame(std::span<Drawable::Shape> shapes,
+                     std::span<const uint32_t> shapeModels,
+                     std::span<const glm::mat4> models, uint32_t layerWidth,
+                     uint32_t layerHeight) {
+  if (!file) {
+    return;
+  }
+
+  Fields fields{};
+  for (size_t i = 0; i < shapes.size(); i++) {
+    const glm::mat4& m = models[shapeModels[i]];
+    if (m != model) {
+      write(Recording::Op::Model);
+      write(m);
+      model = m;
+    }
+
+    Drawable::Shape& shape = shapes[i];
+    size_t type = shape.index();
+    size_t count = pack(shape, fields);
+    Fields& last = previous[type];
+    uint16_t mask = 0;
+    for (size_t f = 0; f < count; f++) {
+      if (fields[f] != last[f]) {
+        mask |= 1 << f;
+      }
+    }
+
+    const std::vector<glm::vec2>* outline = nullptr;
+    if (auto polygon = std::get_if<Drawable::Polygon>(&shape)) {
+      outline = &polygon->vertices();
+      if (!std::ranges::equal(*outline, previousOutline)) {
+        mask |= Recording::OUTLINE_BIT;
+      }
+    }
+
+    write(Recording::Op::Shape);
+    write(static_cast<uint8_t>(type));
+    write(mask);
+    for (size_t f = 0; f < count; f++) {
+      if (mask & (1 << f)) {
+        write(fields[f]);
+      }
+    }
+    last = fields;
+
+    if (mask & Recording::OUTLINE_BIT) {
+      write(static_cast<uint32_t>(outline->size()));
+      auto p = reinterpret_cast<const uint8_t*>(outline->data());
+      buffer.insert(buffer.end(), p,
+                    p + outline->size() * sizeof(glm::vec2));
+      previousOutline = *outline;
+    }
+  }
+
+  if (layerWidth > 0) {
+    write(Recording::Op::LayerFrame);
+    write(layerWidth);
+    write(layerHeight);
+  } else {
+    write(Recording::Op::Frame);
+  }
+  frames++;
+  flush();
+}
+
+void Recorder::flush() {
+  if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+    DUSK_LOG(LogLevel::Error, "Dusk", "Unable to write recording, stopping");
+    std::fclose(file);
+    file = nullptr;
+  }
+  bytes += buffer.size();
+  buffer.clear();
+}
+
+void Recorder::close() {
+  if (!file) {
+    return;
+  }
+  flush();
+  if (file) {
+    std::fclose(file);
+    file = nullptr;
+  }
+}
+
+Replayer::Replayer(const std::string& path) : file(path) {
+  if (!file) {
+    return;
+  }
+  data = file.data();
+  size = file.size();
+
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  if (!read(magic) || !read(version) || magic != Recording::MAGIC ||
+      version != Recording::VERSION) {
+    DUSK_LOG(LogLevel::Error, "Dusk",
+             std::format("{} is not a supported recording", path));
+    data = nullptr;
+    size = 0;
+  }
+}
+
+void Replayer::rewind() {
+  offset = 8;
+  frame = 0;
+  previous = {};
+  previousOutline.clear();
+  model = glm::mat4(1);
+}
+
+bool Replayer::next(Drawer& drawer) {
+  if (!data) {
+    return false;
+  }
+
+  // the drawer resets its matrix after every frame
+  drawer.resetMatrix();
+  drawer.applyMatrix(model);
+
+  Recording::Op op;
+  while (read(op)) {
+    switch (op) {
+      case Recording::Op::Clear: {
+        std::array<float, 4> color;
+        if (!read(color)) {
+          return false;
+        }
+        drawer.clear(color[0], color[1], color[2], color[3]);
+        break;
+      }
+      case Recording::Op::Transform: {
+        glm::mat4 mat;
+        if (!read(mat)) {
+          return false;
+        }
+        drawer.setTransformMatrix(mat);
+        break;
+      }
+      case Recording::Op::Model:
+        if (!read(model)) {
+          return false;
+        }
+        drawer.resetMatrix();
+        drawer.applyMatrix(model);
+        break;
+      case Recording::Op::Shape:
+        if (!readShape(drawer)) {
+          return false;
+        }
+        break;
+      case Recording::Op::Frame:
+        drawer.draw();
+        frame++;
+        return true;
+      case Recording::Op::LayerFrame: {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        if (!read(width) || !read(height)) {
+          return false;
+        }
+        if (layer.getWidth() != width || layer.getHeight() != height) {
+          if (layer) {
+            drawer.releaseLayer(layer);
+          }
+          layer = drawer.createLayer(width, height);
+        }
+        drawer.draw(layer);
+        frame++;
+        return true;
+      }
+      default:
+        DUSK_LOG(LogLevel::Error, "Dusk",
+                 std::format("Malformed recording at byte {}", offset));
+        return false;
+    }
+  }
+  return false;
+}
+
+bool Replayer::readShape(Drawer& drawer) {
+  uint8_t type = 0;
+  uint16_t mask = 0;
+  if (!read(type) || !read(mask) || type >= previous.size()) {
+    return false;
+  }
+
+  Fields& fields = previous[type];
+  for (size_t f = 0; f < Recording::MAX_FIELDS; f++) {
+    if ((mask & (1 << f)) && !read(fields[f])) {
+      return false;
+    }
+  }
+
+  if (mask & Recording::OUTLINE_BIT) {
+    uint32_t count = 0;
+    if (!read(count) || offset + count * sizeof(glm::vec2) > size) {
+      return false;
+    }
+    previousOutline.resize(count);
+    std::memcpy(previousOutline.data(), data + offset,
+                count * sizeof(glm::vec2));
+    offset += count * sizeof(glm::vec2);
+  }
+
+  unpack(type, fields, previousOutline, drawer);
+  return true;
+}
+
+}  // namespace Dusk
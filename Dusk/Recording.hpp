@@ -0,0 +1,155 @@
+#pragma once
+
+#include <Dusk/Drawables.hpp>
+#include <Dusk/Layer.hpp>
+#include <Dusk/MappedFile.hpp>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace Dusk {
+
+class Drawer;
+
+// A recording is a stream of commands in host byte order after an 8 byte
+// header. Shapes are delta encoded against the previous shape of the same
+// type: a bit mask says which of its fields changed and only those follow.
+// The model matrix is written only when it changes between shapes. Layer
+// composites and renderables reference GPU resources and are not recorded,
+// neither are shapes outside Drawable::Shape.
+namespace Recording {
+
+enum class Op : uint8_t {
+  // 4 floats
+  Clear = 1,
+  // 16 floats
+  Transform,
+  // 16 floats, applies to the shapes that follow
+  Model,
+  // type, field mask and the changed fields
+  Shape,
+  // draws the shapes since the last frame into the target
+  Frame,
+  // width and height, draws the shapes since the last frame into a layer
+  LayerFrame
+};
+
+constexpr uint32_t MAGIC = 0x524b5344;  // "DSKR"
+constexpr uint32_t VERSION = 1;
+constexpr size_t MAX_FIELDS = 15;
+// mask bit telling that a polygon outline follows the fields
+constexpr uint16_t OUTLINE_BIT = 1 << MAX_FIELDS;
+
+// raw bits of each field of a shape, so unchanged values compare exactly
+typedef std::array<uint32_t, MAX_FIELDS> Fields;
+typedef std::array<Fields, std::variant_size_v<Drawable::Shape>> ShapeFields;
+
+}  // namespace Recording
+
+// Streams the frames of a Drawer to a file, see Drawer::record().
+class Recorder {
+ public:
+  Recorder() = default;
+  explicit Recorder(const std::string& path);
+  ~Recorder();
+  Recorder(const Recorder&) = delete;
+  Recorder& operator=(const Recorder&) = delete;
+
+  void clear(float r, float g, float b, float a);
+  void transform(const glm::mat4& mat);
+  // Writes the shapes queued for a frame. A layer size of 0 means the frame
+  // was drawn into the drawer's own target.
+  void frame(std::span<Drawable::Shape> shapes,
+             std::span<const uint32_t> shapeModels,
+             std::span<const glm::mat4> models, uint32_t layerWidth = 0,
+             uint32_t layerHeight = 0);
+  void close();
+
+  inline explicit operator bool() const {
+    return file != nullptr;
+  }
+
+  inline uint64_t getFrameCount() {
+    return frames;
+  }
+
+  inline uint64_t getBytesWritten() {
+    return bytes;
+  }
+
+ private:
+  template <typename T>
+  void write(const T& value) {
+    auto p = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), p, p + sizeof(T));
+  }
+
+  void write(Recording::Op op) {
+    buffer.push_back(static_cast<uint8_t>(op));
+  }
+
+  void flush();
+
+  FILE* file = nullptr;
+  std::vector<uint8_t> buffer;
+  Recording::ShapeFields previous{};
+  std::vector<glm::vec2> previousOutline;
+  glm::mat4 model{1};
+  uint64_t frames = 0;
+  uint64_t bytes = 0;
+};
+
+// Plays a recording back into a Drawer as fast as it is fed. The file is
+// memory mapped, so frames are decoded straight from the page cache.
+class Replayer {
+ public:
+  Replayer() = default;
+  explicit Replayer(const std::string& path);
+  Replayer(const Replayer&) = delete;
+  Replayer& operator=(const Replayer&) = delete;
+
+  // Queues the next recorded frame on the drawer and draws it. Returns false
+  // at the end of the recording or on malformed data.
+  bool next(Drawer& drawer);
+  void rewind();
+
+  inline explicit operator bool() const {
+    return data != nullptr;
+  }
+
+  inline uint64_t getFrame() {
+    return frame;
+  }
+
+ private:
+  template <typename T>
+  bool read(T& value) {
+    if (offset + sizeof(T) > size) {
+      return false;
+    }
+    std::memcpy(&value, data + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+  }
+
+  bool readShape(Drawer& drawer);
+
+  MappedFile file;
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+  size_t offset = 0;
+  uint64_t frame = 0;
+  Recording::ShapeFields previous{};
+  std::vector<glm::vec2> previousOutline;
+  glm::mat4 model{1};
+  Layer layer;
+};
+
+}  // namespace Dusk
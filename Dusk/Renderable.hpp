@@ -0,0 +1,42 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <cstdint>
+
+namespace Dusk {
+
+// What a Renderable needs to build pipelines compatible with a Drawer.
+struct RenderContext {
+  wgpu::Device device;
+  wgpu::TextureFormat format;
+  uint32_t sampleCount;
+  // the drawer's projection, a mat4x4f uniform
+  wgpu::Buffer transformBuffer;
+
+  inline bool compatible(const RenderContext& other) const {
+    return device.Get() == other.device.Get() && format == other.format &&
+           sampleCount == other.sampleCount &&
+           transformBuffer.Get() == other.transformBuffer.Get();
+  }
+};
+
+// GPU-driven content that a Drawer records into its frame, in order with
+// the shapes around it. Queue one with Drawer::add() every frame it should
+// be drawn.
+class Renderable {
+ public:
+  virtual ~Renderable() = default;
+
+  // Called every frame before encoding. (Re)creates pipelines when the
+  // context changed and uploads per-frame data.
+  virtual void prepare(const RenderContext& context) = 0;
+
+  // Records work that has to run before the render pass, e.g. compute.
+  virtual void encode([[maybe_unused]] wgpu::CommandEncoder& encoder) {};
+
+  // Records draw calls into the drawer's render pass.
+  virtual void render(wgpu::RenderPassEncoder& pass) = 0;
+};
+
+}  // namespace Dusk
@@ -0,0 +1,133 @@
+#include <Dusk/ShapeQueue.hpp>
+#include <glm/ext/matrix_transform.hpp>
+
+namespace Dusk {
+
+Drawable::Rect& ShapeQueue::rect() {
+  return shape<Drawable::Rect>();
+}
+
+Drawable::Circle& ShapeQueue::circle() {
+  return shape<Drawable::Circle>();
+}
+
+Drawable::Ellipse& ShapeQueue::ellipse() {
+  return shape<Drawable::Ellipse>();
+}
+
+Drawable::Triangle& ShapeQueue::tri() {
+  return shape<Drawable::Triangle>();
+}
+
+Drawable::Line& ShapeQueue::line() {
+  return shape<Drawable::Line>();
+}
+
+Drawable::Polygon& ShapeQueue::polygon() {
+  return shape<Drawable::Polygon>();
+}
+
+Drawable::Circles& ShapeQueue::circles(std::span<const glm::vec2> centers,
+                                       std::span<const float> radii,
+                                       std::span<const glm::vec4> colors) {
+  Drawable::Circles& batch = shape<Drawable::Circles>();
+  batch.centers = centers;
+  batch.radii = radii;
+  batch.colors = colors;
+  return Drawable::Bulk::checked(batch, "circles");
+}
+
+Drawable::Rects& ShapeQueue::rects(std::span<const glm::vec2> positions,
+                                   std::span<const glm::vec2> sizes,
+                                   std::span<const glm::vec4> colors) {
+  Drawable::Rects& batch = shape<Drawable::Rects>();
+  batch.positions = positions;
+  batch.sizes = sizes;
+  batch.colors = colors;
+  return Drawable::Bulk::checked(batch, "rects");
+}
+
+Drawable::Lines& ShapeQueue::lines(std::span<const glm::vec2> from,
+                                   std::span<const glm::vec2> to,
+                                   std::span<const float> thicknesses,
+                                   std::span<const glm::vec4> colors) {
+  Drawable::Lines& batch = shape<Drawable::Lines>();
+  batch.from = from;
+  batch.to = to;
+  batch.thicknesses = thicknesses;
+  batch.colors = colors;
+  return Drawable::Bulk::checked(batch, "lines");
+}
+
+Drawable::Tris& ShapeQueue::tris(std::span<const glm::vec2> corners,
+                                 std::span<const glm::vec4> colors) {
+  Drawable::Tris& batch = shape<Drawable::Tris>();
+  batch.corners = corners;
+  batch.colors = colors;
+  return Drawable::Bulk::checked(batch, "tris");
+}
+
+void ShapeQueue::push() {
+  matrixStack.push_back(matrix);
+}
+
+void ShapeQueue::pop() {
+  if (matrixStack.empty()) {
+    return;
+  }
+  matrix = matrixStack.back();
+  matrixStack.pop_back();
+  matrixDirty = true;
+}
+
+void ShapeQueue::translate(float x, float y, float z) {
+  translate(glm::vec3(x, y, z));
+}
+
+void ShapeQueue::translate(glm::vec2 offset) {
+  translate(glm::vec3(offset, 0));
+}
+
+void ShapeQueue::translate(glm::vec3 offset) {
+  applyMatrix(glm::translate(glm::mat4(1), offset));
+}
+
+void ShapeQueue::rotate(float angle) {
+  applyMatrix(glm::rotate(glm::mat4(1), angle, {0, 0, 1}));
+}
+
+void ShapeQueue::scale(float s) {
+  scale(s, s, s);
+}
+
+void ShapeQueue::scale(float x, float y, float z) {
+  applyMatrix(glm::scale(glm::mat4(1), {x, y, z}));
+}
+
+void ShapeQueue::applyMatrix(const glm::mat4& mat) {
+  matrix = matrix * mat;
+  matrixDirty = true;
+}
+
+void ShapeQueue::resetMatrix() {
+  matrix = glm::mat4(1);
+  matrixDirty = true;
+}
+
+uint32_t ShapeQueue::modelIndex() {
+  if (matrixDirty || models.empty()) {
+    models.push_back(matrix);
+    matrixDirty = false;
+  }
+  return static_cast<uint32_t>(models.size() - 1);
+}
+
+void ShapeQueue::clearQueue() {
+  shapes.forEach([](ShapeRegistry::Bucket& bucket) { bucket.clear(); });
+  drawableModels.clear();
+  models.clear();
+  matrixStack.clear();
+  resetMatrix();
+}
+
+}  // namespace Dusk
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Dusk/Drawables.hpp>
+#include <Dusk/ShapeRegistry.hpp>
+#include <cstdint>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <span>
+#include <vector>
+
+namespace Dusk {
+
+// Shapes in the order they were queued, each with the model matrix that was
+// current at the time. Shared by Drawer and CommandList.
+class ShapeQueue {
+ public:
+  // Queues a shape of any type with a ShapeTraits specialization. Shapes
+  // are drawn in the order they were queued.
+  template <typename T>
+  T& shape() {
+    static_assert(RegisteredShape<T>,
+                  "Specialize Dusk::ShapeTraits to draw this type");
+    const auto ordinal = static_cast<uint32_t>(drawableModels.size());
+    drawableModels.push_back(modelIndex());
+    return shapes.get<T>().add(ordinal);
+  }
+
+  Drawable::Rect& rect();
+  Drawable::Circle& circle();
+  Drawable::Ellipse& ellipse();
+  Drawable::Triangle& tri();
+  Drawable::Line& line();
+  // Filled outline, triangulated once and cached by its content.
+  Drawable::Polygon& polygon();
+
+  // Queue whole arrays of shapes as one shape each, tessellated in a single
+  // loop without a builder per shape. See Drawable::Bulk for the spans.
+  Drawable::Circles& circles(std::span<const glm::vec2> centers,
+                             std::span<const float> radii,
+                             std::span<const glm::vec4> colors);
+  Drawable::Rects& rects(std::span<const glm::vec2> positions,
+                         std::span<const glm::vec2> sizes,
+                         std::span<const glm::vec4> colors);
+  Drawable::Lines& lines(std::span<const glm::vec2> from,
+                         std::span<const glm::vec2> to,
+                         std::span<const float> thicknesses,
+                         std::span<const glm::vec4> colors);
+  Drawable::Tris& tris(std::span<const glm::vec2> corners,
+                       std::span<const glm::vec4> colors);
+
+  // Matrix stack applied to every shape queued afterwards, starting from
+  // the identity on every frame. Each distinct matrix is stored once and
+  // looked up per vertex in the shader, so shapes are never transformed on
+  // the CPU.
+  void push();
+  void pop();
+  void translate(float x, float y, float z = 0);
+  void translate(glm::vec2 offset);
+  void translate(glm::vec3 offset);
+  void rotate(float angle);
+  void scale(float s);
+  void scale(float x, float y, float z = 1);
+  void applyMatrix(const glm::mat4& mat);
+  void resetMatrix();
+
+  inline size_t getShapeCount() {
+    return drawableModels.size();
+  }
+
+ protected:
+  uint32_t modelIndex();
+  // forgets the queued shapes and resets the matrix stack
+  void clearQueue();
+
+  ShapeRegistry::Buckets shapes;
+  // model of every queued shape, in the order they were queued
+  std::vector<uint32_t> drawableModels;
+  std::vector<glm::mat4> models;
+  glm::mat4 matrix{1};
+  std::vector<glm::mat4> matrixStack;
+  bool matrixDirty = true;
+};
+
+}  // namespace Dusk
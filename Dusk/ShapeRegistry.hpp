@@ -0,0 +1,502 @@
+#pragma once
+
+#include <Dusk/Drawables.hpp>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <deque>
+#include <glm/geometric.hpp>
+#include <memory>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <variant>
+#include <vector>
+
+namespace Dusk {
+
+// Where one shape writes its geometry: 3 floats per vertex, 4 per color and
+// indices counted from the shape's own first vertex. The pointers advance as
+// values are written.
+struct Tessellation {
+  float* vertices;
+  float* colors;
+  uint32_t* indices;
+  uint32_t base;
+
+  inline void vertex(float x, float y, float z) {
+    vertices[0] = x;
+    vertices[1] = y;
+    vertices[2] = z;
+    vertices += 3;
+  }
+
+  inline void vertex(glm::vec3 pos) {
+    vertex(pos.x, pos.y, pos.z);
+  }
+
+  // the same color for the next count vertices
+  inline void color(glm::vec4 rgba, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+      colors[0] = rgba.r;
+      colors[1] = rgba.g;
+      colors[2] = rgba.b;
+      colors[3] = rgba.a;
+      colors += 4;
+    }
+  }
+
+  inline void triangle(uint32_t i1, uint32_t i2, uint32_t i3) {
+    indices[0] = base + i1;
+    indices[1] = base + i2;
+    indices[2] = base + i3;
+    indices += 3;
+  }
+};
+
+// Describes how a shape type turns into triangles. Specialize it to draw
+// your own types with Drawer::shape<T>(). A specialization provides
+//
+//   static void tessellate(T& shape, Tessellation& out);
+//
+// and either constants for shapes of a fixed size
+//
+//   static constexpr uint32_t VERTICES = ...;
+//   static constexpr uint32_t INDICES = ...;
+//
+// or functions when the size depends on the shape
+//
+//   static uint32_t vertices(T& shape);
+//   static uint32_t indices(T& shape);
+//
+// tessellate() must write exactly that many vertices, colors and indices.
+template <typename T>
+struct ShapeTraits;
+
+template <typename T>
+concept FixedSizeShape = requires {
+  { ShapeTraits<T>::VERTICES } -> std::convertible_to<uint32_t>;
+  { ShapeTraits<T>::INDICES } -> std::convertible_to<uint32_t>;
+};
+
+template <typename T>
+concept RegisteredShape =
+    requires(T& shape, Tessellation& out) {
+      ShapeTraits<T>::tessellate(shape, out);
+    } &&
+    (FixedSizeShape<T> || requires(T& shape) {
+      { ShapeTraits<T>::vertices(shape) } -> std::convertible_to<uint32_t>;
+      { ShapeTraits<T>::indices(shape) } -> std::convertible_to<uint32_t>;
+    });
+
+template <>
+struct ShapeTraits<Drawable::Rect> {
+  static constexpr uint32_t VERTICES = 4;
+  static constexpr uint32_t INDICES = 6;
+
+  static inline void tessellate(Drawable::Rect& r, Tessellation& out) {
+    out.vertex(r.x(), r.y(), r.z());
+    out.vertex(r.x() + r.w(), r.y(), r.z());
+    out.vertex(r.x() + r.w(), r.y() + r.h(), r.z());
+    out.vertex(r.x(), r.y() + r.h(), r.z());
+    out.color(r.rgba(), VERTICES);
+    out.triangle(0, 1, 2);
+    out.triangle(0, 2, 3);
+  }
+};
+
+// A center vertex and a fan of res vertices around it.
+template <typename T>
+struct FanTraits {
+  static inline uint32_t vertices(T& shape) {
+    return shape.res() + 1;
+  }
+
+  static inline uint32_t indices(T& shape) {
+    return shape.res() * 3;
+  }
+
+  static inline void tessellate(T& shape, Tessellation& out, float w,
+                                float h) {
+    const glm::vec3 center = shape.xyz();
+    const uint32_t res = shape.res();
+    out.vertex(center);
+    for (uint32_t i = 0; i < res; i++) {
+      float id = static_cast<float>(i) / static_cast<float>(res);
+      float theta = id * std::numbers::pi_v<float> * 2.0;
+      out.vertex(cosf(theta) * w + center.x, sinf(theta) * h + center.y,
+                 center.z);
+    }
+    out.color(shape.rgba(), res + 1);
+    for (uint32_t i = 0; i < res; i++) {
+      out.triangle(0, i + 1, (i + 1) % res + 1);
+    }
+  }
+};
+
+template <>
+struct ShapeTraits<Drawable::Circle> : FanTraits<Drawable::Circle> {
+  static inline void tessellate(Drawable::Circle& c, Tessellation& out) {
+    FanTraits::tessellate(c, out, c.radius(), c.radius());
+  }
+};
+
+template <>
+struct ShapeTraits<Drawable::Ellipse> : FanTraits<Drawable::Ellipse> {
+  static inline void tessellate(Drawable::Ellipse& e, Tessellation& out) {
+    FanTraits::tessellate(e, out, e.w(), e.h());
+  }
+};
+
+template <>
+struct ShapeTraits<Drawable::Triangle> {
+  static constexpr uint32_t VERTICES = 3;
+  static constexpr uint32_t INDICES = 3;
+
+  static inline void tessellate(Drawable::Triangle& t, Tessellation& out) {
+    out.vertex(t.p1<glm::vec3>());
+    out.vertex(t.p2<glm::vec3>());
+    out.vertex(t.p3<glm::vec3>());
+    out.color(t.rgba(), VERTICES);
+    out.triangle(0, 1, 2);
+  }
+};
+
+template <>
+struct ShapeTraits<Drawable::Line> {
+  static constexpr uint32_t VERTICES = 4;
+  static constexpr uint32_t INDICES = 6;
+
+  static inline void tessellate(Drawable::Line& l, Tessellation& out) {
+    const glm::vec3 p1 = l.p1<glm::vec3>();
+    const glm::vec3 p2 = l.p2<glm::vec3>();
+    glm::vec3 dir = glm::normalize(p2 - p1) * (l.thickness() * 0.5f);
+    // dir turned a quarter turn about z
+    glm::vec3 bitan(-dir.y, dir.x, dir.z);
+    out.vertex(p1 + bitan);
+    out.vertex(p2 + bitan);
+    out.vertex(p2 - bitan);
+    out.vertex(p1 - bitan);
+    out.color(l.rgba(), VERTICES);
+    out.triangle(0, 1, 2);
+    out.triangle(0, 2, 3);
+  }
+};
+
+// Uses the triangulation the drawer attached before tessellating.
+template <>
+struct ShapeTraits<Drawable::Polygon> {
+  static inline uint32_t vertices(Drawable::Polygon& p) {
+    return p.vertices().size();
+  }
+
+  static inline uint32_t indices(Drawable::Polygon& p) {
+    return p.triangles->size();
+  }
+
+  static inline void tessellate(Drawable::Polygon& p, Tessellation& out) {
+    for (const glm::vec2& v : p.vertices()) {
+      out.vertex(v.x, v.y, 0);
+    }
+    out.color(p.rgba(), p.vertices().size());
+    const std::vector<uint32_t>& triangles = *p.triangles;
+    for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+      out.triangle(triangles[i], triangles[i + 1], triangles[i + 2]);
+    }
+  }
+};
+
+// The bulk shapes write all their shapes in one loop, each shape's indices
+// offset by the vertices of the shapes before it.
+template <>
+struct ShapeTraits<Drawable::Circles> {
+  static inline uint32_t vertices(Drawable::Circles& c) {
+    return c.size() * (c.res() + 1);
+  }
+
+  static inline uint32_t indices(Drawable::Circles& c) {
+    return c.size() * c.res() * 3;
+  }
+
+  static inline void tessellate(Drawable::Circles& c, Tessellation& out) {
+    const uint32_t res = c.res();
+    // the same directions as a single circle's, computed once per batch
+    std::vector<glm::vec2> directions(res);
+    for (uint32_t i = 0; i < res; i++) {
+      float id = static_cast<float>(i) / static_cast<float>(res);
+      float theta = id * std::numbers::pi_v<float> * 2.0;
+      directions[i] = {cosf(theta), sinf(theta)};
+    }
+    const size_t count = c.size();
+    for (size_t n = 0; n < count; n++) {
+      const glm::vec2 center = c.centers[n];
+      const float radius = Drawable::Bulk::at(c.radii, n);
+      out.vertex(center.x, center.y, 0);
+      for (const glm::vec2& d : directions) {
+        out.vertex(d.x * radius + center.x, d.y * radius + center.y, 0);
+      }
+      out.color(Drawable::Bulk::at(c.colors, n), res + 1);
+      const uint32_t first = n * (res + 1);
+      for (uint32_t i = 0; i < res; i++) {
+        out.triangle(first, first + i + 1, first + (i + 1) % res + 1);
+      }
+    }
+  }
+};
+
+template <>
+struct ShapeTraits<Drawable::Rects> {
+  static inline uint32_t vertices(Drawable::Rects& r) {
+    return r.size() * 4;
+  }
+
+  static inline uint32_t indices(Drawable::Rects& r) {
+    return r.size() * 6;
+  }
+
+  static inline void tessellate(Drawable::Rects& r, Tessellation& out) {
+    const size_t count = r.size();
+    for (size_t n = 0; n < count; n++) {
+      const glm::vec2 p = r.positions[n];
+      const glm::vec2 size = Drawable::Bulk::at(r.sizes, n);
+      out.vertex(p.x, p.y, 0);
+      out.vertex(p.x + size.x, p.y, 0);
+      out.vertex(p.x + size.x, p.y + size.y, 0);
+      out.vertex(p.x, p.y + size.y, 0);
+      out.color(Drawable::Bulk::at(r.colors, n), 4);
+      const uint32_t first = n * 4;
+      out.triangle(first, first + 1, first + 2);
+      out.triangle(first, first + 2, first + 3);
+    }
+  }
+};
+
+template <>
+struct ShapeTraits<Drawable::Lines> {
+  static inline uint32_t vertices(Drawable::Lines& l) {
+    return l.size() * 4;
+  }
+
+  static inline uint32_t indices(Drawable::Lines& l) {
+    return l.size() * 6;
+  }
+
+  static inline void tessellate(Drawable::Lines& l, Tessellation& out) {
+    const size_t count = l.size();
+    for (size_t n = 0; n < count; n++) {
+      const glm::vec2 p1 = l.from[n];
+      const glm::vec2 p2 = l.to[n];
+      glm::vec2 dir = glm::normalize(p2 - p1) *
+                      (Drawable::Bulk::at(l.thicknesses, n) * 0.5f);
+      glm::vec2 bitan(-dir.y, dir.x);
+      out.vertex(p1.x + bitan.x, p1.y + bitan.y, 0);
+      out.vertex(p2.x + bitan.x, p2.y + bitan.y, 0);
+      out.vertex(p2.x - bitan.x, p2.y - bitan.y, 0);
+      out.vertex(p1.x - bitan.x, p1.y - bitan.y, 0);
+      out.color(Drawable::Bulk::at(l.colors, n), 4);
+      const uint32_t first = n * 4;
+      out.triangle(first, first + 1, first + 2);
+      out.triangle(first, first + 2, first + 3);
+    }
+  }
+};
+
+template <>
+struct ShapeTraits<Drawable::Tris> {
+  static inline uint32_t vertices(Drawable::Tris& t) {
+    return t.size() * 3;
+  }
+
+  static inline uint32_t indices(Drawable::Tris& t) {
+    return t.size() * 3;
+  }
+
+  static inline void tessellate(Drawable::Tris& t, Tessellation& out) {
+    const size_t count = t.size();
+    for (size_t n = 0; n < count; n++) {
+      for (size_t i = 0; i < 3; i++) {
+        const glm::vec2 p = t.corners[n * 3 + i];
+        out.vertex(p.x, p.y, 0);
+      }
+      out.color(Drawable::Bulk::at(t.colors, n), 3);
+      const uint32_t first = n * 3;
+      out.triangle(first, first + 1, first + 2);
+    }
+  }
+};
+
+namespace ShapeRegistry {
+
+// Dense ids for shape types, handed out on first use.
+inline size_t nextId() {
+  static std::atomic<size_t> next{0};
+  return next++;
+}
+
+template <typename T>
+size_t id() {
+  static const size_t value = nextId();
+  return value;
+}
+
+template <typename T, typename Variant>
+struct IsAlternative;
+
+template <typename T, typename... Ts>
+struct IsAlternative<T, std::variant<Ts...>>
+    : std::bool_constant<(std::is_same_v<T, Ts> || ...)> {};
+
+// whether T is one of the built-in shapes recordings know about
+template <typename T>
+constexpr bool isBuiltin = IsAlternative<T, Drawable::Shape>::value;
+
+// Output arrays of a frame and where each shape starts in them, indexed by
+// the order the shapes were queued in.
+struct Geometry {
+  float* vertices;
+  float* colors;
+  uint32_t* indices;
+  const uint32_t* vertexOffsets;
+  const uint32_t* indexOffsets;
+};
+
+// The shapes of one type queued in a frame. Virtual calls happen once per
+// bucket, the loops over shapes are generated for each type.
+class Bucket {
+ public:
+  virtual ~Bucket() = default;
+  virtual std::unique_ptr<Bucket> clone() const = 0;
+  virtual void clear() = 0;
+  // Writes the vertex and index counts of every shape at its ordinal.
+  virtual void count(uint32_t* vertexCounts, uint32_t* indexCounts) = 0;
+  virtual void tessellate(const Geometry& geometry) = 0;
+  // Copies built-in shapes to their ordinals for recording.
+  virtual void snapshot(std::span<std::optional<Drawable::Shape>> out) = 0;
+};
+
+template <typename T>
+class BucketOf : public Bucket {
+ public:
+  // References stay valid until clear(), a deque does not move its elements
+  // when it grows.
+  inline T& add(uint32_t ordinal) {
+    ordinals.push_back(ordinal);
+    return shapes.emplace_back();
+  }
+
+  inline std::deque<T>& getShapes() {
+    return shapes;
+  }
+
+  // the queue position of each shape
+  inline const std::vector<uint32_t>& getOrdinals() {
+    return ordinals;
+  }
+
+  std::unique_ptr<Bucket> clone() const override {
+    return std::make_unique<BucketOf<T>>(*this);
+  }
+
+  void clear() override {
+    shapes.clear();
+    ordinals.clear();
+  }
+
+  void count(uint32_t* vertexCounts, uint32_t* indexCounts) override {
+    for (size_t i = 0; i < shapes.size(); i++) {
+      if constexpr (FixedSizeShape<T>) {
+        vertexCounts[ordinals[i]] = ShapeTraits<T>::VERTICES;
+        indexCounts[ordinals[i]] = ShapeTraits<T>::INDICES;
+      } else {
+        vertexCounts[ordinals[i]] = ShapeTraits<T>::vertices(shapes[i]);
+        indexCounts[ordinals[i]] = ShapeTraits<T>::indices(shapes[i]);
+      }
+    }
+  }
+
+  void tessellate(const Geometry& geometry) override {
+    for (size_t i = 0; i < shapes.size(); i++) {
+      const uint32_t vertex = geometry.vertexOffsets[ordinals[i]];
+      Tessellation out{geometry.vertices + vertex * 3,
+                       geometry.colors + vertex * 4,
+                       geometry.indices + geometry.indexOffsets[ordinals[i]],
+                       vertex};
+      ShapeTraits<T>::tessellate(shapes[i], out);
+    }
+  }
+
+  void snapshot(std::span<std::optional<Drawable::Shape>> out) override {
+    if constexpr (isBuiltin<T>) {
+      for (size_t i = 0; i < shapes.size(); i++) {
+        out[ordinals[i]] = shapes[i];
+      }
+    }
+  }
+
+ private:
+  std::deque<T> shapes;
+  std::vector<uint32_t> ordinals;
+};
+
+// One bucket per shape type used so far, indexed by id<T>(). Copies get
+// their own shapes.
+class Buckets {
+ public:
+  Buckets() = default;
+
+  Buckets(const Buckets& other) {
+    *this = other;
+  }
+
+  Buckets& operator=(const Buckets& other) {
+    if (this == &other) {
+      return *this;
+    }
+    buckets.clear();
+    for (const auto& bucket : other.buckets) {
+      buckets.push_back(bucket ? bucket->clone() : nullptr);
+    }
+    return *this;
+  }
+
+  Buckets(Buckets&&) = default;
+  Buckets& operator=(Buckets&&) = default;
+
+  template <typename T>
+  BucketOf<T>& get() {
+    const size_t index = id<T>();
+    if (index >= buckets.size()) {
+      buckets.resize(index + 1);
+    }
+    if (!buckets[index]) {
+      buckets[index] = std::make_unique<BucketOf<T>>();
+    }
+    return static_cast<BucketOf<T>&>(*buckets[index]);
+  }
+
+  // null when no shape of the type was ever queued
+  template <typename T>
+  BucketOf<T>* find() {
+    const size_t index = id<T>();
+    if (index >= buckets.size() || !buckets[index]) {
+      return nullptr;
+    }
+    return static_cast<BucketOf<T>*>(buckets[index].get());
+  }
+
+  template <typename F>
+  void forEach(F&& f) {
+    for (const auto& bucket : buckets) {
+      if (bucket) {
+        f(*bucket);
+      }
+    }
+  }
+
+ private:
+  std::vector<std::unique_ptr<Bucket>> buckets;
+};
+
+}  // namespace ShapeRegistry
+}  // namespace Dusk
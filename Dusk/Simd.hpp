@@ -0,0 +1,405 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Dusk::Simd {
+
+// Four floats or four 32 bit unsigned integers worked on side by side, in
+// SSE registers where available and lane by lane elsewhere. Comparisons give
+// masks with every bit of a lane set or clear, for select() and bits().
+//
+// The same functions exist for float and uint32_t, so that a template
+// written against them also runs on single elements and gives the same
+// results there.
+#if defined(__SSE2__)
+struct Float4 {
+  Float4() = default;
+  Float4(float f) : v(_mm_set1_ps(f)) {}
+  explicit Float4(__m128 v) : v(v) {}
+  __m128 v;
+};
+
+struct Int4 {
+  Int4() = default;
+  Int4(uint32_t i) : v(_mm_set1_epi32(static_cast<int32_t>(i))) {}
+  explicit Int4(__m128i v) : v(v) {}
+  __m128i v;
+};
+
+inline Float4 set(float a, float b, float c, float d) {
+  return Float4(_mm_setr_ps(a, b, c, d));
+}
+
+inline Int4 setInt(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+  return Int4(
+      _mm_setr_epi32(static_cast<int32_t>(a), static_cast<int32_t>(b),
+                     static_cast<int32_t>(c), static_cast<int32_t>(d)));
+}
+
+inline Float4 load(const float* p) {
+  return Float4(_mm_loadu_ps(p));
+}
+
+inline void store(float* p, Float4 a) {
+  _mm_storeu_ps(p, a.v);
+}
+
+inline Float4 operator+(Float4 a, Float4 b) {
+  return Float4(_mm_add_ps(a.v, b.v));
+}
+
+inline Float4 operator-(Float4 a, Float4 b) {
+  return Float4(_mm_sub_ps(a.v, b.v));
+}
+
+inline Float4 operator*(Float4 a, Float4 b) {
+  return Float4(_mm_mul_ps(a.v, b.v));
+}
+
+inline Float4 operator/(Float4 a, Float4 b) {
+  return Float4(_mm_div_ps(a.v, b.v));
+}
+
+inline Float4 operator-(Float4 a) {
+  return Float4(_mm_xor_ps(a.v, _mm_set1_ps(-0.0f)));
+}
+
+inline Float4 operator<(Float4 a, Float4 b) {
+  return Float4(_mm_cmplt_ps(a.v, b.v));
+}
+
+inline Float4 operator>(Float4 a, Float4 b) {
+  return Float4(_mm_cmpgt_ps(a.v, b.v));
+}
+
+inline Float4 operator>=(Float4 a, Float4 b) {
+  return Float4(_mm_cmpge_ps(a.v, b.v));
+}
+
+inline Float4 operator&(Float4 a, Float4 b) {
+  return Float4(_mm_and_ps(a.v, b.v));
+}
+
+inline Float4 operator|(Float4 a, Float4 b) {
+  return Float4(_mm_or_ps(a.v, b.v));
+}
+
+// a where the mask is set, b elsewhere
+inline Float4 select(Float4 mask, Float4 a, Float4 b) {
+  return Float4(
+      _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)));
+}
+
+// bit i is set when lane i of the mask is
+inline int bits(Float4 mask) {
+  return _mm_movemask_ps(mask.v);
+}
+
+inline Float4 min(Float4 a, Float4 b) {
+  return Float4(_mm_min_ps(a.v, b.v));
+}
+
+inline Float4 max(Float4 a, Float4 b) {
+  return Float4(_mm_max_ps(a.v, b.v));
+}
+
+// for magnitudes below 2^31
+inline Float4 floor(Float4 a) {
+  __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+  return Float4(
+      _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a.v), _mm_set1_ps(1.0f))));
+}
+
+inline Int4 operator+(Int4 a, Int4 b) {
+  return Int4(_mm_add_epi32(a.v, b.v));
+}
+
+inline Int4 operator*(Int4 a, Int4 b) {
+  // SSE2 only multiplies the even lanes into 64 bits
+  __m128i even = _mm_mul_epu32(a.v, b.v);
+  __m128i odd =
+      _mm_mul_epu32(_mm_srli_epi64(a.v, 32), _mm_srli_epi64(b.v, 32));
+  return Int4(
+      _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                         _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))));
+}
+
+inline Int4 operator^(Int4 a, Int4 b) {
+  return Int4(_mm_xor_si128(a.v, b.v));
+}
+
+inline Int4 operator&(Int4 a, Int4 b) {
+  return Int4(_mm_and_si128(a.v, b.v));
+}
+
+inline Int4 operator>>(Int4 a, int n) {
+  return Int4(_mm_srli_epi32(a.v, n));
+}
+
+// truncates, as signed integers
+inline Int4 toInt(Float4 a) {
+  return Int4(_mm_cvttps_epi32(a.v));
+}
+
+// reads the lanes as signed integers
+inline Float4 toFloat(Int4 a) {
+  return Float4(_mm_cvtepi32_ps(a.v));
+}
+#else
+struct Float4 {
+  Float4() = default;
+  Float4(float f) : v{f, f, f, f} {}
+  float v[4];
+};
+
+struct Int4 {
+  Int4() = default;
+  Int4(uint32_t i) : v{i, i, i, i} {}
+  uint32_t v[4];
+};
+
+template <typename R, typename A, typename F>
+inline R lanewise(A a, A b, F f) {
+  R r;
+  for (int i = 0; i < 4; i++) {
+    r.v[i] = f(a.v[i], b.v[i]);
+  }
+  return r;
+}
+
+inline float maskLane(bool set) {
+  return std::bit_cast<float>(set ? ~0u : 0u);
+}
+
+inline bool isSet(float lane) {
+  return std::bit_cast<uint32_t>(lane) >> 31;
+}
+
+inline Float4 set(float a, float b, float c, float d) {
+  Float4 r;
+  r.v[0] = a;
+  r.v[1] = b;
+  r.v[2] = c;
+  r.v[3] = d;
+  return r;
+}
+
+inline Int4 setInt(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+  Int4 r;
+  r.v[0] = a;
+  r.v[1] = b;
+  r.v[2] = c;
+  r.v[3] = d;
+  return r;
+}
+
+inline Float4 load(const float* p) {
+  return set(p[0], p[1], p[2], p[3]);
+}
+
+inline void store(float* p, Float4 a) {
+  for (int i = 0; i < 4; i++) {
+    p[i] = a.v[i];
+  }
+}
+
+inline Float4 operator+(Float4 a, Float4 b) {
+  return lanewise<Float4>(a, b, [](float x, float y) { return x + y; });
+}
+
+inline Float4 operator-(Float4 a, Float4 b) {
+  return lanewise<Float4>(a, b, [](float x, float y) { return x - y; });
+}
+
+inline Float4 operator*(Float4 a, Float4 b) {
+  return lanewise<Float4>(a, b, [](float x, float y) { return x * y; });
+}
+
+inline Float4 operator/(Float4 a, Float4 b) {
+  return lanewise<Float4>(a, b, [](float x, float y) { return x / y; });
+}
+
+inline Float4 operator-(Float4 a) {
+  return Float4(0.0f) - a;
+}
+
+inline Float4 operator<(Float4 a, Float4 b) {
+  return lanewise<Float4>(a, b,
+                          [](float x, float y) { return maskLane(x < y); });
+}
+
+inline Float4 operator>(Float4 a, Float4 b) {
+  return lanewise<Float4>(a, b,
+                          [](float x, float y) { return maskLane(x > y); });
+}
+
+inline Float4 operator>=(Float4 a, Float4 b) {
+  return lanewise<Float4>(a, b,
+                          [](float x, float y) { return maskLane(x >= y); });
+}
+
+inline Float4 operator&(Float4 a, Float4 b) {
+  return lanewise<Float4>(a, b, [](float x, float y) {
+    return std::bit_cast<float>(std::bit_cast<uint32_t>(x) &
+                                std::bit_cast<uint32_t>(y));
+  });
+}
+
+inline Float4 operator|(Float4 a, Float4 b) {
+  return lanewise<Float4>(a, b, [](float x, float y) {
+    return std::bit_cast<float>(std::bit_cast<uint32_t>(x) |
+                                std::bit_cast<uint32_t>(y));
+  });
+}
+
+inline Float4 select(Float4 mask, Float4 a, Float4 b) {
+  Float4 r;
+  for (int i = 0; i < 4; i++) {
+    r.v[i] = isSet(mask.v[i]) ? a.v[i] : b.v[i];
+  }
+  return r;
+}
+
+inline int bits(Float4 mask) {
+  int r = 0;
+  for (int i = 0; i < 4; i++) {
+    r |= isSet(mask.v[i]) << i;
+  }
+  return r;
+}
+
+inline Float4 min(Float4 a, Float4 b) {
+  return lanewise<Float4>(a, b,
+                          [](float x, float y) { return x < y ? x : y; });
+}
+
+inline Float4 max(Float4 a, Float4 b) {
+  return lanewise<Float4>(a, b,
+                          [](float x, float y) { return x > y ? x : y; });
+}
+
+inline Float4 floor(Float4 a) {
+  for (int i = 0; i < 4; i++) {
+    a.v[i] = std::floor(a.v[i]);
+  }
+  return a;
+}
+
+inline Int4 operator+(Int4 a, Int4 b) {
+  return lanewise<Int4>(a, b, [](uint32_t x, uint32_t y) { return x + y; });
+}
+
+inline Int4 operator*(Int4 a, Int4 b) {
+  return lanewise<Int4>(a, b, [](uint32_t x, uint32_t y) { return x * y; });
+}
+
+inline Int4 operator^(Int4 a, Int4 b) {
+  return lanewise<Int4>(a, b, [](uint32_t x, uint32_t y) { return x ^ y; });
+}
+
+inline Int4 operator&(Int4 a, Int4 b) {
+  return lanewise<Int4>(a, b, [](uint32_t x, uint32_t y) { return x & y; });
+}
+
+inline Int4 operator>>(Int4 a, int n) {
+  for (int i = 0; i < 4; i++) {
+    a.v[i] >>= n;
+  }
+  return a;
+}
+
+inline Int4 toInt(Float4 a) {
+  Int4 r;
+  for (int i = 0; i < 4; i++) {
+    r.v[i] = static_cast<uint32_t>(static_cast<int32_t>(a.v[i]));
+  }
+  return r;
+}
+
+inline Float4 toFloat(Int4 a) {
+  Float4 r;
+  for (int i = 0; i < 4; i++) {
+    r.v[i] = static_cast<float>(static_cast<int32_t>(a.v[i]));
+  }
+  return r;
+}
+#endif
+
+// single element counterparts
+
+inline float select(bool mask, float a, float b) {
+  return mask ? a : b;
+}
+
+inline float min(float a, float b) {
+  return a < b ? a : b;
+}
+
+inline float max(float a, float b) {
+  return a > b ? a : b;
+}
+
+inline float floor(float a) {
+  return std::floor(a);
+}
+
+inline uint32_t toInt(float a) {
+  return static_cast<uint32_t>(static_cast<int32_t>(a));
+}
+
+inline float toFloat(uint32_t a) {
+  return static_cast<float>(static_cast<int32_t>(a));
+}
+
+// The lanes of a float type, their integer counterpart, loads and stores of
+// consecutive or strided elements and consecutive integers from start.
+template <typename T>
+struct Lanes;
+
+template <>
+struct Lanes<float> {
+  using Int = uint32_t;
+  static constexpr size_t width = 1;
+
+  static float gather(const float* p, size_t) {
+    return *p;
+  }
+
+  static void scatter(float* p, float a) {
+    *p = a;
+  }
+
+  static uint32_t sequence(uint32_t start) {
+    return start;
+  }
+};
+
+template <>
+struct Lanes<Float4> {
+  using Int = Int4;
+  static constexpr size_t width = 4;
+
+  static Float4 gather(const float* p, size_t stride) {
+    if (stride == 1) {
+      return load(p);
+    }
+    return set(p[0], p[stride], p[2 * stride], p[3 * stride]);
+  }
+
+  static void scatter(float* p, Float4 a) {
+    store(p, a);
+  }
+
+  static Int4 sequence(uint32_t start) {
+    return setInt(start, start + 1, start + 2, start + 3);
+  }
+};
+
+}  // namespace Dusk::Simd
@@ -0,0 +1,345 @@
+#include <Dusk/Simd.hpp>
+#include <Dusk/SoftwareRasterizer.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <glm/vec4.hpp>
+#include <thread>
+#include <utility>
+
+namespace Dusk {
+
+using Simd::Float4;
+
+// edge length of the square tiles triangles are binned into
+static constexpr int32_t TILE_SIZE = 64;
+// vertices and triangles a thread should have to be worth starting
+static constexpr size_t MIN_VERTICES_PER_THREAD = 16384;
+static constexpr size_t MIN_TRIANGLES_PER_THREAD = 4096;
+// vertices are snapped to 1/SUBPIXELS of a pixel
+static constexpr float SUBPIXELS = 16;
+// the standard positions of 4 samples within a pixel
+static constexpr float SAMPLE_X[4] = {0.375, 0.875, 0.125, 0.625};
+static constexpr float SAMPLE_Y[4] = {0.125, 0.375, 0.625, 0.875};
+
+// RGBA8 with red in the lowest byte, rounded like a unorm render target
+static uint32_t pack(float r, float g, float b, float a) {
+  auto unorm = [](float v) {
+    return static_cast<uint32_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+  };
+  return unorm(r) | unorm(g) << 8 | unorm(b) << 16 | unorm(a) << 24;
+}
+
+// threads worth starting for count items, at least minPerThread each
+static size_t threadsFor(size_t count, size_t threads, size_t minPerThread) {
+  return std::max<size_t>(1, std::min(threads, count / minPerThread));
+}
+
+// Calls f(chunk, begin, end) for as many contiguous chunks of [0, count),
+// each on a thread of its own.
+template <typename F>
+static void parallelFor(size_t count, size_t chunks, F&& f) {
+  if (chunks <= 1) {
+    f(0, 0, count);
+    return;
+  }
+  std::vector<std::jthread> workers;
+  const size_t chunk = (count + chunks - 1) / chunks;
+  for (size_t i = 0; i < chunks; i++) {
+    workers.emplace_back(f, i, std::min(i * chunk, count),
+                         std::min((i + 1) * chunk, count));
+  }
+}
+
+SoftwareRasterizer::SoftwareRasterizer(uint32_t sampleCount, uint32_t threads)
+    : sampleCount(sampleCount > 1 ? 4 : 1),
+      threads(threads ? threads
+                      : std::max(1u, std::thread::hardware_concurrency())) {}
+
+void SoftwareRasterizer::draw(const BackendFrame& frame) {
+  if (frame.width != width || frame.height != height) {
+    width = frame.width;
+    height = frame.height;
+    tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    pixels.assign(static_cast<size_t>(width) * height, 0);
+    if (sampleCount > 1) {
+      samples.assign(pixels.size() * sampleCount, 0);
+    }
+  }
+  project(frame);
+  bin(frame);
+
+  // tiles are handed out one at a time, so that threads done with cheap
+  // tiles take over the remaining ones
+  const uint32_t tileCount = tilesX * tilesY;
+  std::atomic<uint32_t> next = 0;
+  auto work = [&]() {
+    for (uint32_t tile = next++; tile < tileCount; tile = next++) {
+      rasterize(frame, tile);
+    }
+  };
+  const uint32_t count = std::min(threads, tileCount);
+  if (count <= 1) {
+    work();
+  } else {
+    std::vector<std::jthread> workers;
+    for (uint32_t i = 0; i < count; i++) {
+      workers.emplace_back(work);
+    }
+  }
+}
+
+void SoftwareRasterizer::project(const BackendFrame& frame) {
+  const size_t count = frame.vertexModels.size();
+  screen.resize(count * 2);
+  visible.resize(count);
+
+  std::vector<glm::mat4> matrices(frame.models.size());
+  for (size_t i = 0; i < matrices.size(); i++) {
+    matrices[i] = frame.transform * frame.models[i];
+  }
+  const float halfWidth = width * 0.5f;
+  const float halfHeight = height * 0.5f;
+
+  auto work = [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      const float* v = &frame.vertices[3 * i];
+      glm::vec4 p = matrices[frame.vertexModels[i]] * glm::vec4(v[0], v[1],
+                                                                v[2], 1);
+      // normalized device coordinates to pixels, y pointing down
+      float x = std::round((p.x / p.w + 1) * halfWidth * SUBPIXELS);
+      float y = std::round((1 - p.y / p.w) * halfHeight * SUBPIXELS);
+      screen[2 * i] = x / SUBPIXELS;
+      screen[2 * i + 1] = y / SUBPIXELS;
+      visible[i] = p.w > 0 && std::isfinite(x) && std::isfinite(y);
+    }
+  };
+  parallelFor(count, threadsFor(count, threads, MIN_VERTICES_PER_THREAD),
+              work);
+}
+
+void SoftwareRasterizer::bin(const BackendFrame& frame) {
+  const size_t count = frame.indices.size() / 3;
+  triangles.resize(count);
+  const size_t chunks = threadsFor(count, threads, MIN_TRIANGLES_PER_THREAD);
+  bins.resize(chunks);
+  for (auto& lists : bins) {
+    lists.resize(tilesX * tilesY);
+    for (auto& list : lists) {
+      list.clear();
+    }
+  }
+
+  auto work = [&](size_t chunk, size_t begin, size_t end) {
+    auto& lists = bins[chunk];
+    for (size_t i = begin; i < end; i++) {
+      const uint32_t* corners = &frame.indices[3 * i];
+      if (!visible[corners[0]] || !visible[corners[1]] ||
+          !visible[corners[2]]) {
+        continue;
+      }
+      Triangle& t = triangles[i];
+      for (int k = 0; k < 3; k++) {
+        t.vertex[k] = corners[k];
+        t.x[k] = screen[2 * corners[k]];
+        t.y[k] = screen[2 * corners[k] + 1];
+      }
+      float area = (t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) -
+                   (t.y[1] - t.y[0]) * (t.x[2] - t.x[0]);
+      if (area == 0) {
+        continue;
+      }
+      // no culling, either winding is drawn
+      if (area < 0) {
+        std::swap(t.x[1], t.x[2]);
+        std::swap(t.y[1], t.y[2]);
+        std::swap(t.vertex[1], t.vertex[2]);
+      }
+
+      auto [minX, maxX] = std::minmax({t.x[0], t.x[1], t.x[2]});
+      auto [minY, maxY] = std::minmax({t.y[0], t.y[1], t.y[2]});
+      const float w = static_cast<float>(width);
+      const float h = static_cast<float>(height);
+      t.x0 = static_cast<int32_t>(std::clamp(std::floor(minX), 0.0f, w));
+      t.x1 = static_cast<int32_t>(std::clamp(std::ceil(maxX), 0.0f, w));
+      t.y0 = static_cast<int32_t>(std::clamp(std::floor(minY), 0.0f, h));
+      t.y1 = static_cast<int32_t>(std::clamp(std::ceil(maxY), 0.0f, h));
+      if (t.x0 >= t.x1 || t.y0 >= t.y1) {
+        continue;
+      }
+
+      const float* c0 = &frame.colors[4 * t.vertex[0]];
+      const float* c1 = &frame.colors[4 * t.vertex[1]];
+      const float* c2 = &frame.colors[4 * t.vertex[2]];
+      t.flat = std::equal(c0, c0 + 4, c1) && std::equal(c0, c0 + 4, c2);
+      if (t.flat) {
+        t.color = pack(c0[0], c0[1], c0[2], c0[3]);
+      }
+
+      for (int32_t ty = t.y0 / TILE_SIZE; ty <= (t.y1 - 1) / TILE_SIZE;
+           ty++) {
+        for (int32_t tx = t.x0 / TILE_SIZE; tx <= (t.x1 - 1) / TILE_SIZE;
+             tx++) {
+          lists[ty * tilesX + tx].push_back(static_cast<uint32_t>(i));
+        }
+      }
+    }
+  };
+  parallelFor(count, chunks, work);
+}
+
+void SoftwareRasterizer::rasterize(const BackendFrame& frame, uint32_t tile) {
+  const int32_t left = (tile % tilesX) * TILE_SIZE;
+  const int32_t top = (tile / tilesX) * TILE_SIZE;
+  const int32_t right = std::min<int32_t>(width, left + TILE_SIZE);
+  const int32_t bottom = std::min<int32_t>(height, top + TILE_SIZE);
+  const uint32_t s = sampleCount;
+  uint32_t* target = s > 1 ? samples.data() : pixels.data();
+
+  if (frame.clear) {
+    const glm::vec4& c = frame.clearColor;
+    const uint32_t color = pack(c.r, c.g, c.b, c.a);
+    for (int32_t y = top; y < bottom; y++) {
+      const size_t row = static_cast<size_t>(y) * width;
+      std::fill(target + (row + left) * s, target + (row + right) * s, color);
+    }
+  }
+
+  const Float4 sampleX =
+      s > 1 ? Simd::set(SAMPLE_X[0], SAMPLE_X[1], SAMPLE_X[2], SAMPLE_X[3])
+            : Simd::set(0.5, 1.5, 2.5, 3.5);
+  const Float4 sampleY =
+      s > 1 ? Simd::set(SAMPLE_Y[0], SAMPLE_Y[1], SAMPLE_Y[2], SAMPLE_Y[3])
+            : Float4(0.5);
+
+  for (const auto& lists : bins) {
+    for (uint32_t index : lists[tile]) {
+      const Triangle& t = triangles[index];
+      const int32_t x0 = std::max(t.x0, left);
+      const int32_t x1 = std::min(t.x1, right);
+      const int32_t y0 = std::max(t.y0, top);
+      const int32_t y1 = std::min(t.y1, bottom);
+
+      // Edge functions of the corners taken relative to the tile, which
+      // keeps them small. A triangle sharing an edge computes the exact
+      // negation of its values, so exactly one of the two owns the points
+      // on the edge: the triangle on its top or left side.
+      float x[3];
+      float y[3];
+      for (int k = 0; k < 3; k++) {
+        x[k] = t.x[k] - left;
+        y[k] = t.y[k] - top;
+      }
+      float a[3];
+      float b[3];
+      float c[3];
+      bool owns[3];
+      for (int k = 0; k < 3; k++) {
+        const int n = (k + 1) % 3;
+        a[k] = y[k] - y[n];
+        b[k] = x[n] - x[k];
+        c[k] = static_cast<float>(static_cast<double>(x[k]) * y[n] -
+                                  static_cast<double>(y[k]) * x[n]);
+        owns[k] = a[k] > 0 || (a[k] == 0 && b[k] > 0);
+      }
+      // lanes inside all three edges, positive or zero on an owned edge
+      const Float4 laneA[3] = {a[0], a[1], a[2]};
+      auto covered = [&](const Float4* row, Float4 colX) {
+        int inside = 0xf;
+        for (int k = 0; k < 3; k++) {
+          const Float4 e = laneA[k] * colX + row[k];
+          inside &= Simd::bits(owns[k] ? e >= 0.0f : e > 0.0f);
+        }
+        return inside;
+      };
+
+      // Colors are interpolated linearly in screen space at the pixel
+      // center, weighting each corner by the edge opposite to it.
+      const float* colors[3] = {&frame.colors[4 * t.vertex[0]],
+                                &frame.colors[4 * t.vertex[1]],
+                                &frame.colors[4 * t.vertex[2]]};
+      const float inverseArea = 1 / (a[1] * x[0] + b[1] * y[0] + c[1]);
+      auto shade = [&](int32_t px, int32_t py) {
+        if (t.flat) {
+          return t.color;
+        }
+        const float cx = px - left + 0.5f;
+        const float cy = py - top + 0.5f;
+        const float w0 = (a[1] * cx + b[1] * cy + c[1]) * inverseArea;
+        const float w1 = (a[2] * cx + b[2] * cy + c[2]) * inverseArea;
+        const float w2 = 1 - w0 - w1;
+        float rgba[4];
+        for (int i = 0; i < 4; i++) {
+          rgba[i] = colors[0][i] * w0 + colors[1][i] * w1 + colors[2][i] * w2;
+        }
+        return pack(rgba[0], rgba[1], rgba[2], rgba[3]);
+      };
+
+      for (int32_t py = y0; py < y1; py++) {
+        const Float4 rowY = static_cast<float>(py - top) + sampleY;
+        Float4 row[3];
+        for (int k = 0; k < 3; k++) {
+          row[k] = b[k] * rowY + c[k];
+        }
+        uint32_t* out = target + static_cast<size_t>(py) * width * s;
+
+        if (s > 1) {
+          // the lanes are the samples of one pixel
+          for (int32_t px = x0; px < x1; px++) {
+            const int inside =
+                covered(row, static_cast<float>(px - left) + sampleX);
+            if (!inside) {
+              continue;
+            }
+            const uint32_t color = shade(px, py);
+            uint32_t* pixel = out + static_cast<size_t>(px) * s;
+            for (uint32_t k = 0; k < s; k++) {
+              if (inside & (1 << k)) {
+                pixel[k] = color;
+              }
+            }
+          }
+        } else {
+          // the lanes are four pixels in a row
+          for (int32_t px = x0; px < x1; px += 4) {
+            int inside =
+                covered(row, static_cast<float>(px - left) + sampleX);
+            inside &= (1 << std::min(4, x1 - px)) - 1;
+            while (inside) {
+              const int lane = std::countr_zero(static_cast<unsigned>(inside));
+              inside &= inside - 1;
+              out[px + lane] = shade(px + lane, py);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  if (s > 1) {
+    resolve(left, top, right, bottom);
+  }
+}
+
+void SoftwareRasterizer::resolve(uint32_t x0, uint32_t y0, uint32_t x1,
+                                 uint32_t y1) {
+  for (uint32_t y = y0; y < y1; y++) {
+    for (uint32_t x = x0; x < x1; x++) {
+      const size_t pixel = static_cast<size_t>(y) * width + x;
+      const uint32_t* s = &samples[pixel * sampleCount];
+      uint32_t color = 0;
+      for (uint32_t shift = 0; shift < 32; shift += 8) {
+        uint32_t sum = 0;
+        for (uint32_t k = 0; k < sampleCount; k++) {
+          sum += (s[k] >> shift) & 0xff;
+        }
+        color |= ((sum + sampleCount / 2) / sampleCount) << shift;
+      }
+      pixels[pixel] = color;
+    }
+  }
+}
+
+}  // namespace Dusk
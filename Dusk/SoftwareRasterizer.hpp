@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Dusk/Backend.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Dusk {
+
+// Draws frames on the CPU into a buffer of RGBA8 pixels, for machines
+// without a usable GPU. Triangles are binned into square tiles of the
+// target, then every core takes tiles off a shared counter and rasterizes
+// their triangles in queue order, four coverage tests at a time.
+//
+// Rasterization follows the GPU path: pixel centers, the top-left fill
+// rule, the standard 4x sample positions, colors interpolated at the pixel
+// center and written to every covered sample without blending, samples
+// averaged into the pixels. Colors are interpolated linearly in screen
+// space, which matches the GPU for orthographic transforms. Vertices are
+// snapped to 1/16 pixel. Triangles with a vertex behind the camera (w <= 0)
+// are dropped rather than clipped.
+class SoftwareRasterizer : public RenderBackend {
+ public:
+  // A sample count of 1 or 4. No thread count uses one thread per core.
+  explicit SoftwareRasterizer(uint32_t sampleCount = 4, uint32_t threads = 0);
+
+  void draw(const BackendFrame& frame) override;
+
+  // Row-major pixels of the last frame, red in the lowest byte.
+  inline std::span<const uint32_t> getPixels() {
+    return pixels;
+  }
+
+  inline uint32_t getWidth() {
+    return width;
+  }
+
+  inline uint32_t getHeight() {
+    return height;
+  }
+
+  inline uint32_t getSampleCount() {
+    return sampleCount;
+  }
+
+ private:
+  // a triangle in pixels, wound so that its area is positive
+  struct Triangle {
+    float x[3];
+    float y[3];
+    // vertex of each corner, for the colors
+    uint32_t vertex[3];
+    // pixels touched, x1 and y1 exclusive
+    int32_t x0;
+    int32_t y0;
+    int32_t x1;
+    int32_t y1;
+    // packed color when the corners share it
+    uint32_t color;
+    bool flat;
+  };
+
+  void project(const BackendFrame& frame);
+  void bin(const BackendFrame& frame);
+  void rasterize(const BackendFrame& frame, uint32_t tile);
+  void resolve(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1);
+
+  uint32_t sampleCount;
+  uint32_t threads;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t tilesX = 0;
+  uint32_t tilesY = 0;
+  // sampleCount per pixel, only used when multisampling
+  std::vector<uint32_t> samples;
+  std::vector<uint32_t> pixels;
+  // vertices in pixels, x and y interleaved, and whether each is usable
+  std::vector<float> screen;
+  std::vector<uint8_t> visible;
+  std::vector<Triangle> triangles;
+  // triangles overlapping each tile, one list per binning thread so that
+  // reading them thread by thread keeps the queue order
+  std::vector<std::vector<std::vector<uint32_t>>> bins;
+};
+
+}  // namespace Dusk
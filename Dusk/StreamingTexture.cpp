@@ -0,0 +1,299 @@
+#include <Dusk/Log.hpp>
+#include <Dusk/Shader.hpp>
+#include <Dusk/StreamingTexture.hpp>
+#include <algorithm>
+#include <cstring>
+#include <format>
+
+namespace Dusk {
+
+static constexpr const char* QUAD_SHADER = R"(
+    @group(0) @binding(0) var<uniform> transformMat: mat4x4f;
+    // x, y, width and height
+    @group(0) @binding(1) var<uniform> quad: vec4f;
+    @group(0) @binding(2) var frameSampler: sampler;
+    @group(0) @binding(3) var frameTexture: texture_2d<f32>;
+
+    struct VertexOutput {
+        @builtin(position) pos: vec4f,
+        @location(0) uv: vec2f
+    };
+
+    @vertex
+    fn vs_main(@builtin(vertex_index) v: u32) -> VertexOutput {
+        var out: VertexOutput;
+        let corner = vec2f(f32(v & 1u), f32((v >> 1u) & 1u));
+        out.pos = transformMat * vec4f(quad.xy + corner * quad.zw, 0.0, 1.0);
+        out.uv = corner;
+        return out;
+    }
+
+    @fragment
+    fn fs_main(in: VertexOutput) -> @location(0) vec4f {
+        return textureSample(frameTexture, frameSampler, in.uv);
+    }
+)";
+
+StreamingTexture::StreamingTexture(const std::string& path, uint32_t width,
+                                   uint32_t height, uint32_t ring)
+    : file(path),
+      width(width),
+      height(height),
+      frameBytes(static_cast<size_t>(width) * height * 4),
+      slots(std::max(ring, 2u)),
+      quad(0, 0, width, height) {
+  if (!file || frameBytes == 0) {
+    return;
+  }
+  frameCount = file.size() / frameBytes;
+  if (frameCount == 0) {
+    DUSK_LOG(LogLevel::Error, "Dusk",
+             std::format("{} is shorter than a {}x{} frame", path, width,
+                         height));
+    return;
+  }
+  for (Slot& slot : slots) {
+    slot.pixels.resize(frameBytes);
+  }
+  worker = std::thread([this]() { read(); });
+}
+
+StreamingTexture::~StreamingTexture() {
+  {
+    std::lock_guard lock(mutex);
+    stopping = true;
+  }
+  changed.notify_all();
+  if (worker.joinable()) {
+    worker.join();
+  }
+}
+
+StreamingTexture& StreamingTexture::frame(uint64_t index) {
+  if (frameCount > 0) {
+    std::lock_guard lock(mutex);
+    current = index % frameCount;
+  }
+  changed.notify_all();
+  return *this;
+}
+
+StreamingTexture& StreamingTexture::rect(float x, float y, float w, float h) {
+  quad = {x, y, w, h};
+  return *this;
+}
+
+bool StreamingTexture::wanted(uint64_t frame) {
+  return frame != NONE &&
+         (frame + frameCount - current) % frameCount < slots.size();
+}
+
+bool StreamingTexture::nextRead(size_t& slot, uint64_t& frame) {
+  slot = slots.size();
+  for (size_t i = 0; i < slots.size(); i++) {
+    const Slot& s = slots[i];
+    const bool onScreen = i == shown && s.uploaded != NONE;
+    if (s.staged == NONE && !onScreen && !wanted(s.uploaded)) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot == slots.size()) {
+    return false;
+  }
+  const uint64_t ahead = std::min<uint64_t>(slots.size(), frameCount);
+  for (uint64_t k = 0; k < ahead; k++) {
+    frame = (current + k) % frameCount;
+    bool held = std::any_of(slots.begin(), slots.end(), [&](const Slot& s) {
+      return s.staged == frame || s.uploaded == frame;
+    });
+    if (!held) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void StreamingTexture::read() {
+  std::unique_lock lock(mutex);
+  while (true) {
+    size_t index = 0;
+    uint64_t next = 0;
+    changed.wait(lock,
+                 [&]() { return stopping || nextRead(index, next); });
+    if (stopping) {
+      return;
+    }
+    Slot& slot = slots[index];
+    slot.staged = next;
+    slot.ready = false;
+    lock.unlock();
+
+    // page faults of the mapping happen here, off the render thread, while
+    // the kernel already reads the frame after
+    file.prefetch((next + 1) % frameCount * frameBytes, frameBytes);
+    std::memcpy(slot.pixels.data(), file.data() + next * frameBytes,
+                frameBytes);
+
+    lock.lock();
+    slot.ready = true;
+  }
+}
+
+void StreamingTexture::createTextures() {
+  wgpu::TextureDescriptor desc{};
+  desc.usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst;
+  desc.format = wgpu::TextureFormat::RGBA8Unorm;
+  desc.size.width = width;
+  desc.size.height = height;
+  desc.size.depthOrArrayLayers = 1;
+
+  std::lock_guard lock(mutex);
+  for (Slot& slot : slots) {
+    slot.texture = ctx.device.CreateTexture(&desc);
+    slot.uploaded = NONE;
+  }
+
+  wgpu::SamplerDescriptor samplerDesc{};
+  samplerDesc.magFilter = wgpu::FilterMode::Linear;
+  samplerDesc.minFilter = wgpu::FilterMode::Linear;
+  sampler = ctx.device.CreateSampler(&samplerDesc);
+
+  wgpu::BufferDescriptor bufferDesc{};
+  bufferDesc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+  bufferDesc.size = sizeof(glm::vec4);
+  quadBuffer = ctx.device.CreateBuffer(&bufferDesc);
+}
+
+void StreamingTexture::createPipeline() {
+  wgpu::Device device = ctx.device;
+  Dusk::Shader shader = Dusk::ShaderBuilder().source(QUAD_SHADER).build(device);
+
+  wgpu::BlendState blend;
+  blend.color.srcFactor = wgpu::BlendFactor::SrcAlpha;
+  blend.color.dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha;
+  blend.color.operation = wgpu::BlendOperation::Add;
+  blend.alpha.srcFactor = wgpu::BlendFactor::One;
+  blend.alpha.dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha;
+  blend.alpha.operation = wgpu::BlendOperation::Add;
+
+  wgpu::ColorTargetState colTarget;
+  colTarget.format = ctx.format;
+  colTarget.blend = &blend;
+  wgpu::FragmentState frag;
+  frag.module = shader.mod;
+  frag.entryPoint = "fs_main";
+  frag.targetCount = 1;
+  frag.targets = &colTarget;
+
+  wgpu::RenderPipelineDescriptor pipelineDesc;
+  pipelineDesc.vertex.module = shader.mod;
+  pipelineDesc.vertex.entryPoint = "vs_main";
+  pipelineDesc.primitive.topology = wgpu::PrimitiveTopology::TriangleStrip;
+  pipelineDesc.fragment = &frag;
+  pipelineDesc.multisample.count = ctx.sampleCount;
+  pipelineDesc.multisample.mask = ~0u;
+  pipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+  // one bind group per texture of the ring
+  for (Slot& slot : slots) {
+    wgpu::BindGroupEntry entries[4];
+    entries[0].binding = 0;
+    entries[0].buffer = ctx.transformBuffer;
+    entries[0].size = sizeof(float) * 16;
+    entries[1].binding = 1;
+    entries[1].buffer = quadBuffer;
+    entries[1].size = sizeof(glm::vec4);
+    entries[2].binding = 2;
+    entries[2].sampler = sampler;
+    entries[3].binding = 3;
+    entries[3].textureView = slot.texture.CreateView();
+
+    wgpu::BindGroupDescriptor desc{};
+    desc.layout = pipeline.GetBindGroupLayout(0);
+    desc.entryCount = 4;
+    desc.entries = entries;
+    slot.bindGroup = device.CreateBindGroup(&desc);
+  }
+}
+
+void StreamingTexture::prepare(const RenderContext& context) {
+  if (!*this) {
+    return;
+  }
+  if (!ctx.compatible(context)) {
+    const bool newDevice = ctx.device.Get() != context.device.Get();
+    ctx = context;
+    if (newDevice) {
+      createTextures();
+    }
+    pipeline = nullptr;
+  }
+  if (!pipeline) {
+    createPipeline();
+  }
+
+  // frames the worker finished reading, those that fell behind the current
+  // frame meanwhile are dropped
+  std::vector<Slot*> uploads;
+  {
+    std::lock_guard lock(mutex);
+    for (Slot& slot : slots) {
+      if (!slot.ready) {
+        continue;
+      }
+      if (wanted(slot.staged)) {
+        uploads.push_back(&slot);
+      } else {
+        slot.staged = NONE;
+        slot.ready = false;
+      }
+    }
+  }
+
+  // the worker leaves staged slots alone, so they upload without the lock
+  wgpu::Queue queue = ctx.device.GetQueue();
+  for (Slot* slot : uploads) {
+    wgpu::ImageCopyTexture destination{};
+    destination.texture = slot->texture;
+    wgpu::TextureDataLayout layout{};
+    layout.bytesPerRow = width * 4;
+    layout.rowsPerImage = height;
+    wgpu::Extent3D size{width, height, 1};
+    queue.WriteTexture(&destination, slot->pixels.data(), frameBytes, &layout,
+                       &size);
+  }
+
+  {
+    std::lock_guard lock(mutex);
+    for (Slot* slot : uploads) {
+      slot->uploaded = slot->staged;
+      slot->staged = NONE;
+      slot->ready = false;
+    }
+    bool found = false;
+    for (size_t i = 0; i < slots.size(); i++) {
+      if (slots[i].uploaded == current) {
+        shown = i;
+        found = true;
+      }
+    }
+    if (!found) {
+      lateFrames++;
+    }
+  }
+  changed.notify_all();
+
+  queue.WriteBuffer(quadBuffer, 0, &quad, sizeof(glm::vec4));
+}
+
+void StreamingTexture::render(wgpu::RenderPassEncoder& pass) {
+  if (!pipeline || slots[shown].uploaded == NONE) {
+    return;
+  }
+  pass.SetPipeline(pipeline);
+  pass.SetBindGroup(0, slots[shown].bindGroup);
+  pass.Draw(4);
+}
+
+}  // namespace Dusk
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/MappedFile.hpp>
+#include <Dusk/Renderable.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <glm/vec4.hpp>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Dusk {
+
+// Plays a sequence of frames as a texture, e.g. a pre-decoded video or an
+// image sequence used as a background. The frames are raw RGBA8 images of
+// the same size one after the other in a file, such as what
+//
+//   ffmpeg -i in.mp4 -f rawvideo -pix_fmt rgba frames.rgba
+//
+// writes. A worker thread reads the frames following the one asked for
+// from the memory mapped file into staging memory, and prepare() uploads
+// each with WriteTexture into a ring of textures before it is shown. The
+// render thread never waits for the file: a frame that is not read yet
+// leaves the last one on screen.
+//
+// As a Renderable it draws the current frame as a quad, queue it with
+// Drawer::add() every frame it should be shown.
+class StreamingTexture : public Renderable {
+ public:
+  // ring is the number of textures, frames are read up to ring - 1 ahead.
+  StreamingTexture(const std::string& path, uint32_t width, uint32_t height,
+                   uint32_t ring = 4);
+  ~StreamingTexture();
+  StreamingTexture(const StreamingTexture&) = delete;
+  StreamingTexture& operator=(const StreamingTexture&) = delete;
+
+  // The frame to show, wrapped around the length of the sequence.
+  StreamingTexture& frame(uint64_t index);
+  // Where the quad goes, in the units of the drawer's projection.
+  StreamingTexture& rect(float x, float y, float w, float h);
+
+  inline uint64_t getFrameCount() {
+    return frameCount;
+  }
+
+  inline uint32_t getWidth() {
+    return width;
+  }
+
+  inline uint32_t getHeight() {
+    return height;
+  }
+
+  // Texture holding the frame shown last, null before the first
+  // prepare(). Its contents change as the ring turns over.
+  inline const wgpu::Texture& getTexture() {
+    return slots[shown].texture;
+  }
+
+  // frames prepared while the one asked for was not read yet
+  inline uint64_t getLateFrames() {
+    return lateFrames;
+  }
+
+  inline explicit operator bool() const {
+    return frameCount > 0;
+  }
+
+  void prepare(const RenderContext& context) override;
+  void render(wgpu::RenderPassEncoder& pass) override;
+
+ private:
+  static constexpr uint64_t NONE = UINT64_MAX;
+
+  // A staging buffer and the texture it is uploaded into.
+  struct Slot {
+    std::vector<uint8_t> pixels;
+    // the frame in pixels waiting for upload, or the worker is reading it
+    uint64_t staged = NONE;
+    bool ready = false;
+    uint64_t uploaded = NONE;
+    wgpu::Texture texture;
+    wgpu::BindGroup bindGroup;
+  };
+
+  void read();
+  // whether a frame is one of the ring's worth from the current one on
+  bool wanted(uint64_t frame);
+  // the first wanted frame no slot holds and a slot to read it into
+  bool nextRead(size_t& slot, uint64_t& frame);
+  void createTextures();
+  void createPipeline();
+
+  MappedFile file;
+  uint32_t width;
+  uint32_t height;
+  size_t frameBytes;
+  uint64_t frameCount = 0;
+
+  // guards the slots' frame numbers and current, never held while reading
+  // the file or uploading
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::vector<Slot> slots;
+  uint64_t current = 0;
+  size_t shown = 0;
+  bool stopping = false;
+  std::thread worker;
+  uint64_t lateFrames = 0;
+
+  glm::vec4 quad{0};
+  RenderContext ctx{};
+  wgpu::RenderPipeline pipeline;
+  wgpu::Sampler sampler;
+  wgpu::Buffer quadBuffer;
+};
+
+}  // namespace Dusk
@@ -0,0 +1,60 @@
+#include <Dusk/TexturePool.hpp>
+#include <algorithm>
+
+namespace Dusk {
+
+TexturePool::TexturePool(wgpu::Device& device) : device(device) {}
+
+wgpu::Texture TexturePool::acquire(const TextureKey& key) {
+  auto it = available.find(key);
+  if (it != available.end() && !it->second.empty()) {
+    wgpu::Texture texture = it->second.back().texture;
+    it->second.pop_back();
+    return texture;
+  }
+
+  wgpu::TextureDescriptor desc{};
+  desc.usage = key.usage;
+  desc.format = key.format;
+  desc.sampleCount = key.samples;
+  desc.size.width = key.width;
+  desc.size.height = key.height;
+  desc.size.depthOrArrayLayers = 1;
+  return device.CreateTexture(&desc);
+}
+
+void TexturePool::release(wgpu::Texture texture) {
+  if (!texture) {
+    return;
+  }
+  TextureKey key = {texture.GetWidth(), texture.GetHeight(),
+                    texture.GetFormat(), texture.GetSampleCount(),
+                    texture.GetUsage()};
+  available[key].push_back({texture, frame});
+}
+
+void TexturePool::nextFrame() {
+  frame++;
+  for (auto it = available.begin(); it != available.end();) {
+    auto& entries = it->second;
+    std::erase_if(entries, [this](Entry& e) {
+      if (frame - e.releasedAt > maxIdleFrames) {
+        e.texture.Destroy();
+        return true;
+      }
+      return false;
+    });
+    it = entries.empty() ? available.erase(it) : std::next(it);
+  }
+}
+
+void TexturePool::clear() {
+  for (auto& [key, entries] : available) {
+    for (auto& e : entries) {
+      e.texture.Destroy();
+    }
+  }
+  available.clear();
+}
+
+}  // namespace Dusk
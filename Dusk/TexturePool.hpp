@@ -0,0 +1,59 @@
+#pragma once
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <compare>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace Dusk {
+
+struct TextureKey {
+  uint32_t width;
+  uint32_t height;
+  wgpu::TextureFormat format;
+  uint32_t samples;
+  wgpu::TextureUsage usage;
+
+  auto operator<=>(const TextureKey&) const = default;
+};
+
+// Recycles textures by (size, format, samples, usage). Released textures are
+// kept around and handed out again by acquire(); textures that have not been
+// reused for maxIdleFrames calls to nextFrame() are dropped.
+class TexturePool {
+ public:
+  TexturePool() = default;
+  TexturePool(wgpu::Device& device);
+
+  wgpu::Texture acquire(const TextureKey& key);
+  void release(wgpu::Texture texture);
+  void nextFrame();
+  void clear();
+
+  inline void setMaxIdleFrames(uint64_t frames) {
+    maxIdleFrames = frames;
+  }
+
+  inline size_t getFreeCount() {
+    size_t count = 0;
+    for (auto& [key, entries] : available) {
+      count += entries.size();
+    }
+    return count;
+  }
+
+ private:
+  struct Entry {
+    wgpu::Texture texture;
+    uint64_t releasedAt;
+  };
+
+  wgpu::Device device;
+  std::map<TextureKey, std::vector<Entry>> available;
+  uint64_t frame = 0;
+  uint64_t maxIdleFrames = 120;
+};
+
+}  // namespace Dusk
@@ -0,0 +1,67 @@
+#include <Dusk/Log.hpp>
+#include <Dusk/TileWriter.hpp>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <format>
+
+namespace Dusk {
+
+TileWriter::TileWriter(const std::string& path, uint32_t width,
+                       uint32_t height)
+    : width(width), height(height) {
+  fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    DUSK_LOG(LogLevel::Error, "Dusk", std::format("Unable to open {}", path));
+    return;
+  }
+  const std::string header = std::format("P6\n{} {}\n255\n", width, height);
+  offset = header.size();
+  // sized up front, tiles that were never written read as black
+  const off_t size = offset + static_cast<off_t>(width) * height * 3;
+  if (pwrite(fd, header.data(), header.size(), 0) !=
+          static_cast<ssize_t>(header.size()) ||
+      ftruncate(fd, size) != 0) {
+    DUSK_LOG(LogLevel::Error, "Dusk", std::format("Unable to write {}", path));
+    failed = true;
+  }
+}
+
+TileWriter::~TileWriter() {
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+bool TileWriter::write(uint32_t x, uint32_t y, uint32_t w, uint32_t h,
+                       const uint8_t* pixels, size_t stride, bool bgra) {
+  if (!*this) {
+    return false;
+  }
+  if (x >= width || y >= height) {
+    return true;
+  }
+  w = std::min(w, width - x);
+  h = std::min(h, height - y);
+  const int r = bgra ? 2 : 0;
+  const int b = bgra ? 0 : 2;
+  row.resize(static_cast<size_t>(w) * 3);
+  for (uint32_t j = 0; j < h; j++) {
+    const uint8_t* in = pixels + j * stride;
+    for (uint32_t i = 0; i < w; i++) {
+      row[i * 3] = in[i * 4 + r];
+      row[i * 3 + 1] = in[i * 4 + 1];
+      row[i * 3 + 2] = in[i * 4 + b];
+    }
+    const off_t at = offset + (static_cast<off_t>(y + j) * width + x) * 3;
+    if (pwrite(fd, row.data(), row.size(), at) !=
+        static_cast<ssize_t>(row.size())) {
+      DUSK_LOG(LogLevel::Error, "Dusk", "Unable to write image rows");
+      failed = true;
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace Dusk
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Dusk {
+
+// Writes a binary PPM image a rectangle at a time. Rows go straight to
+// their place in the file with pwrite(), so tiles can arrive in any order
+// and the image is never held in memory as a whole.
+class TileWriter {
+ public:
+  TileWriter() = default;
+  TileWriter(const std::string& path, uint32_t width, uint32_t height);
+  ~TileWriter();
+  TileWriter(const TileWriter&) = delete;
+  TileWriter& operator=(const TileWriter&) = delete;
+
+  // Writes the 8 bit RGBA or BGRA pixels of a w by h rectangle at x, y,
+  // whose rows are stride bytes apart. Parts outside the image are dropped.
+  // Returns false once a write failed.
+  bool write(uint32_t x, uint32_t y, uint32_t w, uint32_t h,
+             const uint8_t* pixels, size_t stride, bool bgra = false);
+
+  inline uint32_t getWidth() {
+    return width;
+  }
+
+  inline uint32_t getHeight() {
+    return height;
+  }
+
+  inline explicit operator bool() const {
+    return fd >= 0 && !failed;
+  }
+
+ private:
+  int fd = -1;
+  bool failed = false;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  // where the pixels start, after the header
+  size_t offset = 0;
+  std::vector<uint8_t> row;
+};
+
+}  // namespace Dusk
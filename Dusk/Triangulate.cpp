@@ -0,0 +1,168 @@
+#include <Dusk/Triangulate.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/geometric.hpp>
+
+namespace Dusk {
+
+// upper bound of segments per curve
+static constexpr float MAX_SEGMENTS = 1024;
+
+static float cross(glm::vec2 a, glm::vec2 b, glm::vec2 c) {
+  return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+void flattenQuadratic(std::vector<glm::vec2>& out, glm::vec2 p0, glm::vec2 p1,
+                      glm::vec2 p2, float tolerance) {
+  // Wang's formula for degree 2
+  float m = glm::length(p0 - 2.0f * p1 + p2);
+  float n = std::ceil(std::sqrt(0.25f * m / tolerance));
+  n = std::clamp(n, 1.0f, MAX_SEGMENTS);
+  for (float i = 1; i <= n; i++) {
+    float t = i / n;
+    float u = 1 - t;
+    out.push_back(u * u * p0 + 2 * u * t * p1 + t * t * p2);
+  }
+}
+
+void flattenCubic(std::vector<glm::vec2>& out, glm::vec2 p0, glm::vec2 p1,
+                  glm::vec2 p2, glm::vec2 p3, float tolerance) {
+  // Wang's formula for degree 3
+  float m = std::max(glm::length(p0 - 2.0f * p1 + p2),
+                     glm::length(p1 - 2.0f * p2 + p3));
+  float n = std::ceil(std::sqrt(0.75f * m / tolerance));
+  n = std::clamp(n, 1.0f, MAX_SEGMENTS);
+  for (float i = 1; i <= n; i++) {
+    float t = i / n;
+    float u = 1 - t;
+    out.push_back(u * u * u * p0 + 3 * u * u * t * p1 + 3 * u * t * t * p2 +
+                  t * t * t * p3);
+  }
+}
+
+void triangulate(std::span<const glm::vec2> polygon,
+                 std::vector<uint32_t>& out) {
+  const uint32_t n = polygon.size();
+  if (n < 3) {
+    return;
+  }
+
+  // doubly linked ring of the vertices still to clip, skipping repeated
+  // points and a closing point equal to the first
+  std::vector<uint32_t> prev(n);
+  std::vector<uint32_t> next(n);
+  std::vector<uint32_t> ring;
+  ring.reserve(n);
+  for (uint32_t i = 0; i < n; i++) {
+    if (!ring.empty() && polygon[i] == polygon[ring.back()]) {
+      continue;
+    }
+    ring.push_back(i);
+  }
+  while (ring.size() > 1 && polygon[ring.front()] == polygon[ring.back()]) {
+    ring.pop_back();
+  }
+  uint32_t remaining = ring.size();
+  if (remaining < 3) {
+    return;
+  }
+  for (uint32_t i = 0; i < remaining; i++) {
+    prev[ring[i]] = ring[(i + remaining - 1) % remaining];
+    next[ring[i]] = ring[(i + 1) % remaining];
+  }
+
+  float area = 0;
+  for (uint32_t i : ring) {
+    const glm::vec2 a = polygon[i];
+    const glm::vec2 b = polygon[next[i]];
+    area += a.x * b.y - b.x * a.y;
+  }
+  const float winding = area < 0 ? -1.0f : 1.0f;
+
+  auto convex = [&](uint32_t a, uint32_t b, uint32_t c) {
+    return winding * cross(polygon[a], polygon[b], polygon[c]) > 0;
+  };
+
+  auto isEar = [&](uint32_t a, uint32_t b, uint32_t c) {
+    if (!convex(a, b, c)) {
+      return false;
+    }
+    const glm::vec2 pa = polygon[a];
+    const glm::vec2 pb = polygon[b];
+    const glm::vec2 pc = polygon[c];
+    // only reflex vertices can lie inside an ear
+    for (uint32_t v = next[c]; v != a; v = next[v]) {
+      if (convex(prev[v], v, next[v])) {
+        continue;
+      }
+      const glm::vec2 p = polygon[v];
+      if (winding * cross(pa, pb, p) >= 0 && winding * cross(pb, pc, p) >= 0 &&
+          winding * cross(pc, pa, p) >= 0) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  out.reserve(out.size() + (remaining - 2) * 3);
+  uint32_t i = ring[0];
+  uint32_t stalled = 0;
+  while (remaining > 3) {
+    const uint32_t a = prev[i];
+    const uint32_t c = next[i];
+    // after a full lap without an ear the input is not simple, clip anyway
+    if (isEar(a, i, c) || stalled >= remaining) {
+      out.insert(out.end(), {a, i, c});
+      next[a] = c;
+      prev[c] = a;
+      remaining--;
+      stalled = 0;
+      i = c;
+    } else {
+      i = c;
+      stalled++;
+    }
+  }
+  out.insert(out.end(), {prev[i], i, next[i]});
+}
+
+uint64_t TriangulationCache::hash(std::span<const glm::vec2> polygon) {
+  // FNV-1a over the raw coordinates
+  uint64_t h = 14695981039346656037ull;
+  for (const glm::vec2& p : polygon) {
+    uint32_t words[2];
+    std::memcpy(words, &p, sizeof(words));
+    for (uint32_t w : words) {
+      h = (h ^ w) * 1099511628211ull;
+    }
+  }
+  return h ^ polygon.size();
+}
+
+const std::vector<uint32_t>* TriangulationCache::find(
+    std::span<const glm::vec2> polygon, uint64_t hash) {
+  auto it = entries.find(hash);
+  if (it == entries.end() ||
+      !std::equal(polygon.begin(), polygon.end(), it->second.polygon.begin(),
+                  it->second.polygon.end())) {
+    return nullptr;
+  }
+  it->second.lastUsed = frame;
+  return &it->second.indices;
+}
+
+void TriangulationCache::insert(std::span<const glm::vec2> polygon,
+                                uint64_t hash, std::vector<uint32_t> indices) {
+  entries[hash] = {std::vector<glm::vec2>(polygon.begin(), polygon.end()),
+                   std::move(indices), frame};
+}
+
+void TriangulationCache::nextFrame() {
+  frame++;
+  std::erase_if(entries, [this](const auto& item) {
+    return frame - item.second.lastUsed > maxIdleFrames;
+  });
+}
+
+}  // namespace Dusk
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Dusk {
+
+// Appends points approximating the curve after p0, so that no point of the
+// curve is further than tolerance away from the resulting polyline.
+void flattenQuadratic(std::vector<glm::vec2>& out, glm::vec2 p0, glm::vec2 p1,
+                      glm::vec2 p2, float tolerance);
+void flattenCubic(std::vector<glm::vec2>& out, glm::vec2 p0, glm::vec2 p1,
+                  glm::vec2 p2, glm::vec2 p3, float tolerance);
+
+// Ear clipping triangulation of a simple polygon in either winding order.
+// Appends indices into polygon to out. Self-intersecting input still
+// terminates but may produce overlapping triangles.
+void triangulate(std::span<const glm::vec2> polygon,
+                 std::vector<uint32_t>& out);
+
+// Triangulations keyed by the content of the outline, so unchanged outlines
+// are not triangulated again. Entries unused for maxIdleFrames calls to
+// nextFrame() are dropped.
+class TriangulationCache {
+ public:
+  static uint64_t hash(std::span<const glm::vec2> polygon);
+
+  // Returns nullptr when the outline is not cached.
+  const std::vector<uint32_t>* find(std::span<const glm::vec2> polygon,
+                                    uint64_t hash);
+  void insert(std::span<const glm::vec2> polygon, uint64_t hash,
+              std::vector<uint32_t> indices);
+  void nextFrame();
+
+  inline void setMaxIdleFrames(uint64_t frames) {
+    maxIdleFrames = frames;
+  }
+
+  inline size_t size() {
+    return entries.size();
+  }
+
+ private:
+  struct Entry {
+    std::vector<glm::vec2> polygon;
+    std::vector<uint32_t> indices;
+    uint64_t lastUsed;
+  };
+
+  std::unordered_map<uint64_t, Entry> entries;
+  uint64_t frame = 0;
+  uint64_t maxIdleFrames = 60;
+};
+
+}  // namespace Dusk
@@ -0,0 +1,18 @@
+#include <Dusk/Window.hpp>
+
+namespace Dusk {
+
+Window::~Window() {
+  // the drawer holds the surface too, release both before the window
+  drawer = Dusk::Drawer();
+  surface = nullptr;
+  if (window) {
+    glfwDestroyWindow(window);
+  }
+}
+
+bool Window::isOpen() {
+  return window && !glfwWindowShouldClose(window);
+}
+
+}  // namespace Dusk
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <GLFW/glfw3.h>
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/Drawer.hpp>
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+namespace Dusk {
+
+// A further window of an App. It renders on the App's device and its drawer
+// shares the pipelines and texture pool of the main drawer. Windows are
+// created with App::createWindow() and drawn together with the main window
+// by App::drawWindows().
+class Window {
+ public:
+  ~Window();
+  Window(const Window&) = delete;
+  Window& operator=(const Window&) = delete;
+
+  Dusk::Drawer drawer;
+
+  inline int getWidth() {
+    return width;
+  }
+
+  inline int getHeight() {
+    return height;
+  }
+
+  inline glm::vec2 getCenter() {
+    return {width * 0.5, height * 0.5};
+  }
+
+  // The Event::window of events from this window. The main window is 0.
+  inline uint32_t getIndex() {
+    return index;
+  }
+
+  // False once the window was closed, after which it is no longer drawn.
+  bool isOpen();
+
+ private:
+  friend class App;
+  Window() = default;
+
+  GLFWwindow* window = nullptr;
+  wgpu::Surface surface;
+  int width = 0;
+  int height = 0;
+  uint32_t index = 0;
+};
+
+}  // namespace Dusk
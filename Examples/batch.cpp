@@ -0,0 +1,406 @@
+// Times the span functions of Dusk::Batch against computing the same values
+// one element at a time, and checks the results against scalar references
+// written independently below, with std::sin as the reference for
+// Batch::sin. The WGSL versions then run in a compute shader on a sample of
+// the same inputs and are compared with the CPU results. Exits with 1 when a
+// difference is above its tolerance.
+//
+//   batch [elements] [loops]
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/Batch.hpp>
+#include <Dusk/Builder/BindGroup.hpp>
+#include <Dusk/Builder/Buffer.hpp>
+#include <Dusk/Compute.hpp>
+#include <Dusk/Device.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <numbers>
+#include <span>
+#include <string>
+#include <vector>
+
+using Dusk::Batch::Ease;
+
+// The CPU functions round in float where the references use double, the
+// quintic curves lose the most to cancellation.
+static constexpr float NOISE_TOLERANCE = 1e-5;
+static constexpr float EASE_TOLERANCE = 4e-6;
+static constexpr float SIN_TOLERANCE = 1e-6;
+// The GPU may fuse multiplies and adds and rounds at its own precision.
+// random() is integer math up to an exact conversion and must match exactly.
+static constexpr float GPU_TOLERANCE = 1e-4;
+
+static constexpr std::array<const char*, 12> EASE_NAMES = {
+    "linear",       "quad in",     "quad out",     "quad in out",
+    "cubic in",     "cubic out",   "cubic in out", "sine in",
+    "sine out",     "sine in out", "smoothstep",   "smootherstep"};
+
+// inputs compared on the GPU and the values the shader writes for each,
+// which GPU_SOURCE repeats
+static constexpr size_t GPU_SAMPLES = 1 << 16;
+static constexpr uint32_t GPU_SEED = 5;
+static constexpr size_t GPU_RESULTS = 6 + EASE_NAMES.size();
+
+static const char* GPU_SOURCE = R"(
+    const RESULTS = 18u;
+    const SEED = 5u;
+
+    @group(0) @binding(0) var<storage, read> points: array<vec4f>;
+    @group(0) @binding(1) var<storage, read> times: array<f32>;
+    @group(0) @binding(2) var<storage, read_write> results: array<f32>;
+
+    @compute @workgroup_size(64)
+    fn main(@builtin(global_invocation_id) id: vec3u) {
+        let i = id.x;
+        if (i >= arrayLength(&times)) {
+            return;
+        }
+        let p = points[i];
+        let o = i * RESULTS;
+        results[o] = dusk_noise1(p.x, SEED);
+        results[o + 1u] = dusk_noise2(p.xy, SEED);
+        results[o + 2u] = dusk_noise3(p.xyz, SEED);
+        results[o + 3u] = dusk_noise4(p, SEED);
+        results[o + 4u] = dusk_random(i, SEED);
+        results[o + 5u] = dusk_sin(p.x);
+        for (var c = 0u; c < 12u; c++) {
+            results[o + 6u + c] = dusk_ease(c, times[i]);
+        }
+    }
+)";
+
+// Written from the definitions rather than from Batch's templates, so that a
+// mistake there does not repeat here.
+namespace Reference {
+
+// lowbias32 by Chris Wellons
+static uint32_t hash(uint32_t h) {
+  h ^= h >> 16;
+  h *= 0x7feb352du;
+  h ^= h >> 15;
+  h *= 0x846ca68bu;
+  return h ^ (h >> 16);
+}
+
+// Perlin noise as the sum over the corners of the cell around p of each
+// corner's gradient dotted with the offset to it, weighted by the fade
+// curves of the distances.
+static float noise(const float* p, size_t dims, uint32_t seed) {
+  static constexpr uint32_t PRIMES[4] = {0x9e3779b1, 0x85ebca77, 0xc2b2ae3d,
+                                         0x27d4eb2f};
+  static constexpr double SCALE[4] = {2.15, 1.36, 1.15, 1.2};
+  int32_t cell[4];
+  double f[4];
+  double w[4];
+  for (size_t k = 0; k < dims; k++) {
+    const double i = std::floor(static_cast<double>(p[k]));
+    cell[k] = static_cast<int32_t>(i);
+    f[k] = p[k] - i;
+    w[k] = f[k] * f[k] * f[k] * (f[k] * (f[k] * 6 - 15) + 10);
+  }
+  double sum = 0;
+  for (uint32_t c = 0; c < (1u << dims); c++) {
+    uint32_t h = seed;
+    for (size_t k = 0; k < dims; k++) {
+      const uint32_t corner = static_cast<uint32_t>(cell[k]) + ((c >> k) & 1);
+      h += corner * PRIMES[k];
+    }
+    h = hash(h);
+    double dot = 0;
+    double weight = 1;
+    for (size_t k = 0; k < dims; k++) {
+      const bool far = (c >> k) & 1;
+      const double g = ((h >> (8 * k)) & 255) / 127.5 - 1;
+      dot += g * (far ? f[k] - 1 : f[k]);
+      weight *= far ? w[k] : 1 - w[k];
+    }
+    sum += weight * dot;
+  }
+  return static_cast<float>(sum * SCALE[dims - 1]);
+}
+
+static float ease(Ease curve, float x) {
+  constexpr double pi = std::numbers::pi;
+  const double t = std::clamp(static_cast<double>(x), 0.0, 1.0);
+  switch (curve) {
+    case Ease::Linear:
+      return t;
+    case Ease::QuadIn:
+      return std::pow(t, 2);
+    case Ease::QuadOut:
+      return 1 - std::pow(1 - t, 2);
+    case Ease::QuadInOut:
+      return t < 0.5 ? 2 * std::pow(t, 2) : 1 - std::pow(2 - 2 * t, 2) / 2;
+    case Ease::CubicIn:
+      return std::pow(t, 3);
+    case Ease::CubicOut:
+      return 1 - std::pow(1 - t, 3);
+    case Ease::CubicInOut:
+      return t < 0.5 ? 4 * std::pow(t, 3) : 1 - std::pow(2 - 2 * t, 3) / 2;
+    case Ease::SineIn:
+      return 1 - std::cos(t * pi / 2);
+    case Ease::SineOut:
+      return std::sin(t * pi / 2);
+    case Ease::SineInOut:
+      return (1 - std::cos(t * pi)) / 2;
+    case Ease::Smoothstep:
+      return t * t * (3 - 2 * t);
+    case Ease::Smootherstep:
+      return t * t * t * (t * (t * 6 - 15) + 10);
+  }
+  return t;
+}
+
+static float random(uint32_t index, uint32_t seed) {
+  return (hash(index ^ hash(seed)) >> 8) / 16777216.0;
+}
+
+}  // namespace Reference
+
+template <typename F>
+static double measure(int loops, F&& f) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < loops; i++) {
+    f();
+  }
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / loops;
+}
+
+static float maxDifference(std::span<const float> a,
+                           std::span<const float> b) {
+  float difference = 0;
+  for (size_t i = 0; i < a.size(); i++) {
+    difference = std::max(difference, std::abs(a[i] - b[i]));
+  }
+  return difference;
+}
+
+static bool check(float difference, float tolerance) {
+  const bool ok = difference <= tolerance;
+  std::cout << std::format(", max difference {:.1e} of {:.0e} {}", difference,
+                           tolerance, ok ? "ok" : "FAILED")
+            << std::endl;
+  return ok;
+}
+
+// Batch results have to match the one-at-a-time ones exactly and the
+// reference within the tolerance.
+static bool report(const std::string& name, double batch, double scalar,
+                   const std::vector<float>& out,
+                   const std::vector<float>& single,
+                   const std::vector<float>& reference, float tolerance) {
+  std::cout << std::format("{:<16} {:8.3f} ms {:8.3f} ms scalar {:5.1f}x",
+                           name, batch, scalar, scalar / batch);
+  const bool identical = maxDifference(out, single) == 0;
+  if (!identical) {
+    std::cout << ", differs from one at a time";
+  }
+  return check(maxDifference(out, reference), tolerance) && identical;
+}
+
+// Runs the WGSL functions on the points and times and compares each result
+// with the CPU version.
+static bool compareGpu(std::span<const glm::vec4> points,
+                       std::span<const float> times) {
+  wgpu::InstanceDescriptor instanceDesc{};
+  instanceDesc.features.timedWaitAnyEnable = true;
+  wgpu::Instance instance = wgpu::CreateInstance(&instanceDesc);
+  wgpu::Device device = Dusk::requestDevice(instance);
+  if (!device) {
+    std::cout << "No GPU, the WGSL functions were not compared" << std::endl;
+    return true;
+  }
+
+  const size_t count = times.size();
+  wgpu::Buffer pointBuffer =
+      Dusk::Builder::Buffer<glm::vec4, wgpu::BufferUsage::Storage>()
+          .data(points)
+          .build(device);
+  wgpu::Buffer timeBuffer =
+      Dusk::Builder::Buffer<float, wgpu::BufferUsage::Storage>()
+          .data(times)
+          .build(device);
+  wgpu::Buffer resultBuffer =
+      Dusk::Builder::Buffer<float, wgpu::BufferUsage::Storage>()
+          .size(count * GPU_RESULTS)
+          .addUsage(wgpu::BufferUsage::CopySrc)
+          .build(device);
+  wgpu::BufferDescriptor readbackDesc{};
+  readbackDesc.size = resultBuffer.GetSize();
+  readbackDesc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead;
+  wgpu::Buffer readback = device.CreateBuffer(&readbackDesc);
+
+  Dusk::Compute compute(device);
+  const std::string source = std::string(Dusk::Batch::wgsl()) + GPU_SOURCE;
+  wgpu::ComputePipeline pipeline = compute.pipeline(source.c_str());
+  wgpu::BindGroup bindGroup = Dusk::Builder::BindGroup()
+                                  .layout(pipeline.GetBindGroupLayout(0))
+                                  .buffer(0, pointBuffer)
+                                  .buffer(1, timeBuffer)
+                                  .buffer(2, resultBuffer)
+                                  .build(device);
+  const auto groups = static_cast<uint32_t>((count + 63) / 64);
+  compute.dispatch(pipeline, bindGroup, groups).submit();
+  wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+  encoder.CopyBufferToBuffer(resultBuffer, 0, readback, 0, readbackDesc.size);
+  wgpu::CommandBuffer commands = encoder.Finish();
+  device.GetQueue().Submit(1, &commands);
+
+  bool mapped = false;
+  wgpu::BufferMapCallbackInfo callbackInfo{};
+  callbackInfo.mode = wgpu::CallbackMode::WaitAnyOnly;
+  callbackInfo.userdata = &mapped;
+  callbackInfo.callback = [](WGPUBufferMapAsyncStatus status, void* userdata) {
+    *static_cast<bool*>(userdata) = status == WGPUBufferMapAsyncStatus_Success;
+  };
+  instance.WaitAny(readback.MapAsync(wgpu::MapMode::Read, 0,
+                                     readbackDesc.size, callbackInfo),
+                   UINT64_MAX);
+  if (!mapped) {
+    std::cerr << "Unable to read the shader's results back" << std::endl;
+    return false;
+  }
+  auto results = static_cast<const float*>(
+      readback.GetConstMappedRange(0, readbackDesc.size));
+
+  // the CPU's value of each of the shader's results for one input
+  auto expected = [&](size_t i, size_t r) {
+    const glm::vec4 p = points[i];
+    switch (r) {
+      case 0:
+        return Dusk::Batch::noise(p.x, GPU_SEED);
+      case 1:
+        return Dusk::Batch::noise(glm::vec2(p.x, p.y), GPU_SEED);
+      case 2:
+        return Dusk::Batch::noise(glm::vec3(p.x, p.y, p.z), GPU_SEED);
+      case 3:
+        return Dusk::Batch::noise(p, GPU_SEED);
+      case 4:
+        return Dusk::Batch::random(static_cast<uint32_t>(i), GPU_SEED);
+      case 5:
+        return Dusk::Batch::sin(p.x);
+      default:
+        return Dusk::Batch::ease(static_cast<Ease>(r - 6), times[i]);
+    }
+  };
+  bool ok = true;
+  for (size_t r = 0; r < GPU_RESULTS; r++) {
+    float difference = 0;
+    for (size_t i = 0; i < count; i++) {
+      difference = std::max(
+          difference, std::abs(results[i * GPU_RESULTS + r] - expected(i, r)));
+    }
+    std::string name = r < 4    ? std::format("noise {}d", r + 1)
+                       : r == 4 ? "random"
+                       : r == 5 ? "sin"
+                                : EASE_NAMES[r - 6];
+    std::cout << std::format("wgsl {:<16}", name);
+    ok = check(difference, r == 4 ? 0 : GPU_TOLERANCE) && ok;
+  }
+  readback.Unmap();
+  return ok;
+}
+
+int main(int argc, char** argv) {
+  size_t count = argc > 1 ? std::atoi(argv[1]) : 1 << 20;
+  int loops = argc > 2 ? std::atoi(argv[2]) : 10;
+
+  std::vector<float> x(count);
+  Dusk::Batch::Random random(1);
+  random.fill(x, -100, 100);
+  std::vector<glm::vec2> p2(count);
+  std::vector<glm::vec3> p3(count);
+  std::vector<glm::vec4> p4(count);
+  for (size_t i = 0; i < count; i++) {
+    p2[i] = {x[i], x[count - 1 - i]};
+    p3[i] = {x[i], x[count - 1 - i], x[i] * 0.5f};
+    p4[i] = {x[i], x[count - 1 - i], x[i] * 0.5f, x[i] * 0.25f};
+  }
+  std::vector<float> out(count);
+  std::vector<float> single(count);
+  std::vector<float> reference(count);
+  bool ok = true;
+
+  auto compareNoise = [&]<typename V>(const char* name,
+                                      const std::vector<V>& points) {
+    double batch = measure(loops, [&]() { Dusk::Batch::noise(points, out); });
+    double scalar = measure(loops, [&]() {
+      for (size_t i = 0; i < count; i++) {
+        single[i] = Dusk::Batch::noise(points[i]);
+      }
+    });
+    constexpr size_t dims = sizeof(V) / sizeof(float);
+    for (size_t i = 0; i < count; i++) {
+      reference[i] = Reference::noise(
+          reinterpret_cast<const float*>(&points[i]), dims, 0);
+    }
+    ok = report(name, batch, scalar, out, single, reference,
+                NOISE_TOLERANCE) &&
+         ok;
+  };
+  compareNoise("noise 1d", x);
+  compareNoise("noise 2d", p2);
+  compareNoise("noise 3d", p3);
+  compareNoise("noise 4d", p4);
+
+  double batch = measure(loops, [&]() { Dusk::Batch::sin(x, out); });
+  double scalar = measure(loops, [&]() {
+    for (size_t i = 0; i < count; i++) {
+      single[i] = Dusk::Batch::sin(x[i]);
+    }
+  });
+  for (size_t i = 0; i < count; i++) {
+    reference[i] = std::sin(x[i]);
+  }
+  ok = report("sin", batch, scalar, out, single, reference, SIN_TOLERANCE) &&
+       ok;
+
+  // a little outside [0, 1] to cover the clamping
+  std::vector<float> t(count);
+  random.fill(t, -0.1, 1.1);
+  for (size_t c = 0; c < EASE_NAMES.size(); c++) {
+    auto curve = static_cast<Ease>(c);
+    batch = measure(loops, [&]() { Dusk::Batch::ease(curve, t, out); });
+    scalar = measure(loops, [&]() {
+      for (size_t i = 0; i < count; i++) {
+        single[i] = Dusk::Batch::ease(curve, t[i]);
+      }
+    });
+    for (size_t i = 0; i < count; i++) {
+      reference[i] = Reference::ease(curve, t[i]);
+    }
+    ok = report(EASE_NAMES[c], batch, scalar, out, single, reference,
+                EASE_TOLERANCE) &&
+         ok;
+  }
+
+  batch = measure(loops, [&]() {
+    Dusk::Batch::Random generator(2);
+    generator.fill(out);
+  });
+  scalar = measure(loops, [&]() {
+    Dusk::Batch::Random generator(2);
+    for (size_t i = 0; i < count; i++) {
+      single[i] = generator.next();
+    }
+  });
+  for (size_t i = 0; i < count; i++) {
+    reference[i] = Reference::random(static_cast<uint32_t>(i), 2);
+  }
+  ok = report("random", batch, scalar, out, single, reference, 0) && ok;
+
+  const size_t samples = std::min(count, GPU_SAMPLES);
+  ok = compareGpu(std::span(p4).first(samples),
+                  std::span(t).first(samples)) &&
+       ok;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,53 @@
+#include <Dusk/App.hpp>
+#include <cmath>
+#include <numbers>
+
+// A shape type of our own. The interface mixins give it the same fluent
+// setters as the built-in shapes.
+class Star : public Dusk::Drawable::Interface::Position<Star>,
+             public Dusk::Drawable::Interface::Radius<Star>,
+             public Dusk::Drawable::Interface::Color<Star> {};
+
+// Five points around a center vertex, inner vertices at half the radius.
+template <>
+struct Dusk::ShapeTraits<Star> {
+  static constexpr uint32_t POINTS = 5;
+  static constexpr uint32_t VERTICES = POINTS * 2 + 1;
+  static constexpr uint32_t INDICES = POINTS * 2 * 3;
+
+  static void tessellate(Star& s, Dusk::Tessellation& out) {
+    const glm::vec3 center = s.xyz();
+    out.vertex(center);
+    for (uint32_t i = 0; i < POINTS * 2; i++) {
+      float theta = i * std::numbers::pi_v<float> / POINTS;
+      float r = i % 2 == 0 ? s.radius() : s.radius() * 0.5f;
+      out.vertex(center.x + sinf(theta) * r, center.y - cosf(theta) * r,
+                 center.z);
+    }
+    out.color(s.rgba(), VERTICES);
+    for (uint32_t i = 0; i < POINTS * 2; i++) {
+      out.triangle(0, i + 1, (i + 1) % (POINTS * 2) + 1);
+    }
+  }
+};
+
+class CustomShape : public Dusk::App {
+  void draw() {
+    drawer.clear(0.1);
+    float t = static_cast<float>(glfwGetTime());
+    for (int i = 0; i < 12; i++) {
+      float angle = t * 0.5f + i * std::numbers::pi_v<float> / 6;
+      glm::vec2 pos =
+          getCenter() + glm::vec2(cosf(angle), sinf(angle)) * 220.0f;
+      // stars and circles stay in the order they were queued
+      drawer.circle().xy(pos).radius(30).rgba(0.2, 0.3, 0.8);
+      drawer.shape<Star>().xy(pos).radius(40).rgba(1, 0.8, 0.2);
+    }
+    drawer.draw();
+  }
+};
+
+int main() {
+  CustomShape app;
+  app.run();
+}
@@ -0,0 +1,64 @@
+#include <Dusk/App.hpp>
+#include <Dusk/Dataset.hpp>
+#include <cmath>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+// Writes a few million points scattered around random walks, standing in for
+// GPS traces.
+static void generate(const std::string& path, int width, int height) {
+  const size_t tracks = 2000;
+  const size_t pointsPerTrack = 2000;
+  std::vector<float> x, y, sizes;
+  std::vector<uint32_t> colors;
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> uniform(0, 1);
+  std::normal_distribution<float> step(0, 1.5);
+
+  for (size_t t = 0; t < tracks; t++) {
+    glm::vec2 pos(uniform(rng) * width, uniform(rng) * height);
+    float heading = uniform(rng) * 6.283f;
+    auto r = static_cast<uint32_t>(80 + uniform(rng) * 175);
+    auto g = static_cast<uint32_t>(80 + uniform(rng) * 175);
+    uint32_t color = r | (g << 8) | (255u << 16) | (90u << 24);
+    for (size_t i = 0; i < pointsPerTrack; i++) {
+      heading += step(rng) * 0.1f;
+      pos += glm::vec2(std::cos(heading), std::sin(heading)) * 0.6f;
+      x.push_back(pos.x + step(rng));
+      y.push_back(pos.y + step(rng));
+      sizes.push_back(1.5);
+      colors.push_back(color);
+    }
+  }
+  Dusk::Dataset::write(path, x, y, sizes, colors);
+}
+
+class DatasetViewer : public Dusk::App {
+ public:
+  std::string path = "points.dskd";
+
+ private:
+  Dusk::Dataset dataset;
+
+  void setup() {
+    if (!std::filesystem::exists(path)) {
+      generate(path, getWidth(), getHeight());
+    }
+    dataset = Dusk::Dataset(path);
+  }
+
+  void draw() {
+    drawer.clear(0.05);
+    drawer.add(dataset);
+    drawer.draw();
+  }
+};
+
+int main(int argc, char** argv) {
+  DatasetViewer app;
+  if (argc > 1) {
+    app.path = argv[1];
+  }
+  app.run();
+}
@@ -0,0 +1,32 @@
+#include <Dusk/App.hpp>
+
+class Feedback : public Dusk::App {
+  Dusk::Layer prev;
+  Dusk::Layer next;
+
+  void setup() {
+    prev = drawer.createLayer();
+    next = drawer.createLayer();
+  }
+
+  void draw() {
+    float t = static_cast<float>(glfwGetTime());
+    glm::vec2 pos = getCenter() + glm::vec2(cosf(t), sinf(t * 1.3)) * 200.0f;
+
+    // fade the previous frame into the next one and draw on top of it
+    drawer.clear(0);
+    drawer.composite(prev, 0.96);
+    drawer.circle().xy(pos).radius(20).rgba(1, 0.5, 0.2);
+    drawer.draw(next);
+
+    drawer.composite(next);
+    drawer.draw();
+
+    std::swap(prev, next);
+  }
+};
+
+int main() {
+  Feedback app;
+  app.run();
+}
@@ -1,7 +1,21 @@
 #include <Dusk/App.hpp>
 #include <Dusk/Drawables.hpp>
+#include <optional>
 
 class ManyCircles : public Dusk::App {
+ public:
+  // frames are written here when a path is given, see Examples/replay.cpp
+  std::optional<Dusk::Recorder> recorder;
+
+ private:
+  void setup() {
+    // segment counts follow each circle's radius instead of a fixed 90
+    drawer.enableAdaptiveResolution();
+    if (recorder) {
+      drawer.record(&*recorder);
+    }
+  }
+
   void draw() {
     drawer.clear(0);
 
@@ -24,7 +38,10 @@ class ManyCircles : public Dusk::App {
   }
 };
 
-int main() {
+int main(int argc, char** argv) {
   ManyCircles app;
+  if (argc > 1) {
+    app.recorder.emplace(argv[1]);
+  }
   app.run();
 }
\ No newline at end of file
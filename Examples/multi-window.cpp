@@ -0,0 +1,52 @@
+#include <Dusk/App.hpp>
+#include <Dusk/Drawables.hpp>
+#include <cmath>
+
+// A show output plus a small control window. Dragging in the control window
+// moves the scene on the output; both render from one device and one submit.
+class Show : public Dusk::App {
+  Dusk::Window* control = nullptr;
+  glm::vec2 focus{0.5, 0.5};
+
+  void setup() {
+    control = &createWindow(480, 270, "Control");
+  }
+
+  void onMouseDragged(double mouseX, double mouseY) {
+    if (getEventWindow() == control->getIndex()) {
+      focus = {mouseX / control->getWidth(), mouseY / control->getHeight()};
+    }
+  }
+
+  void scene(Dusk::Drawer& d, glm::vec2 size, float t) {
+    glm::vec2 center = focus * size;
+    for (int i = 0; i < 12; i++) {
+      float angle = t + i * 0.5236f;
+      glm::vec2 pos =
+          center + glm::vec2(std::cos(angle), std::sin(angle)) * size.y * 0.3f;
+      d.circle().xy(pos).radius(size.y * 0.04f).rgba(
+          0.5 + 0.5 * std::sin(angle), 0.4, 0.9);
+    }
+  }
+
+  void draw() {
+    float t = static_cast<float>(glfwGetTime());
+    drawer.clear(0);
+    scene(drawer, {getWidth(), getHeight()}, t);
+
+    control->drawer.clear(0.15);
+    scene(control->drawer, {control->getWidth(), control->getHeight()}, t);
+    control->drawer.rect()
+        .xy(focus * glm::vec2(control->getWidth(), control->getHeight()) -
+            glm::vec2(4))
+        .wh(8, 8)
+        .rgba(1, 1, 0);
+
+    drawWindows();
+  }
+};
+
+int main() {
+  Show app;
+  app.run();
+}
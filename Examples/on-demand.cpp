@@ -0,0 +1,75 @@
+#include <Dusk/App.hpp>
+#include <Dusk/Batch.hpp>
+#include <array>
+#include <mutex>
+
+// A dashboard that sleeps until something changes: a new reading every two
+// seconds, a click, which animates a pulse for a second, or a resize. The
+// duty cycle is logged every few seconds.
+class OnDemand : public Dusk::App {
+  static constexpr size_t BARS = 24;
+  static constexpr double READING_INTERVAL = 2.0;
+
+ public:
+  OnDemand() {
+    setRenderOnDemand(true);
+    setReportDutyCycle(true);
+  }
+
+ private:
+  std::mutex mutex;
+  std::array<float, BARS> readings{};
+  uint32_t readingCount = 0;
+  double lastReading = 0;
+  glm::vec2 pulse{0};
+  double pulseStart = -1;
+
+  // runs once per frame and on idle wakeups, polling for new data
+  void update() {
+    double now = glfwGetTime();
+    if (now - lastReading < READING_INTERVAL) {
+      return;
+    }
+    lastReading = now;
+    {
+      std::lock_guard lock(mutex);
+      readings[readingCount % BARS] = Dusk::Batch::random(readingCount);
+      readingCount++;
+    }
+    requestRedraw();
+  }
+
+  void draw() {
+    drawer.clear(0.05);
+    float barWidth = static_cast<float>(getWidth()) / BARS;
+    {
+      std::lock_guard lock(mutex);
+      for (size_t i = 0; i < BARS; i++) {
+        float h = readings[i] * getHeight() * 0.8f;
+        drawer.rect()
+            .xy(i * barWidth + 2, getHeight() - h)
+            .wh(barWidth - 4, h)
+            .rgba(0.2, 0.6, 1.0);
+      }
+    }
+
+    float age = static_cast<float>(glfwGetTime() - pulseStart);
+    if (pulseStart >= 0 && age < 1) {
+      // fades towards the background, shapes are not blended
+      float v = 1 - age * 0.95f;
+      drawer.circle().xy(pulse).radius(20 + age * 80).rgba(v, v, v);
+    }
+    drawer.draw();
+  }
+
+  void onMousePressed(double mouseX, double mouseY, int) {
+    pulse = {mouseX, mouseY};
+    pulseStart = glfwGetTime();
+    animateFor(1.0);
+  }
+};
+
+int main() {
+  OnDemand app;
+  app.run();
+}
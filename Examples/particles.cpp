@@ -0,0 +1,31 @@
+#include <Dusk/App.hpp>
+#include <Dusk/Particles.hpp>
+
+class Particles : public Dusk::App {
+  Dusk::ParticleSystem particles;
+
+  void setup() {
+    particles = Dusk::ParticleSystem(device, 500000);
+    particles.lifetime(6)
+        .size(2)
+        .gravity({0, 30})
+        .drag(0.3)
+        .addEmitter({getCenter(), 40, 250, {1.0, 0.6, 0.2, 0.6}})
+        .addAttractor({getCenter(), 0});
+  }
+
+  void onMouseMoved(double mouseX, double mouseY) {
+    particles.getAttractor(0) = {{mouseX, mouseY}, 4e6};
+  }
+
+  void draw() {
+    drawer.clear(0);
+    drawer.add(particles);
+    drawer.draw();
+  }
+};
+
+int main() {
+  Particles app;
+  app.run();
+}
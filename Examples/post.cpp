@@ -0,0 +1,31 @@
+#include <Dusk/App.hpp>
+
+class Post : public Dusk::App {
+  Dusk::PostChain post;
+
+  void setup() {
+    post.feedback(0.92, "vec2f(sin(uv.y * 10.0 + time), 0.0) * 0.002")
+        .bloom(0.6, 12, 1.5)
+        .grade(0.2, 1.1, 1.2)
+        .vignette(0.8);
+    drawer.setPostChain(&post);
+  }
+
+  void draw() {
+    float t = static_cast<float>(glfwGetTime());
+    drawer.clear(0);
+    for (int i = 0; i < 8; i++) {
+      float a = t + i * 0.785f;
+      glm::vec2 pos = getCenter() + glm::vec2(cosf(a), sinf(a * 1.3)) * 250.0f;
+      drawer.circle().xy(pos).radius(12).rgba(1, 0.4 + i * 0.07, 0.2);
+    }
+    // the bloom threshold pulses over time
+    post.set(1, {0.5 + 0.2 * sinf(t), 12, 1.5, 0});
+    drawer.draw();
+  }
+};
+
+int main() {
+  Post app;
+  app.run();
+}
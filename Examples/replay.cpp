@@ -0,0 +1,71 @@
+// Replays a recording made with Dusk::Recorder (e.g. `many-circles out.dskr`)
+// into a headless drawer as fast as the GPU allows and reports the timings.
+//
+//   replay <recording> [width] [height] [loops]
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/Device.hpp>
+#include <Dusk/Drawer.hpp>
+#include <Dusk/Recording.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::cerr << "usage: replay <recording> [width] [height] [loops]"
+              << std::endl;
+    return 1;
+  }
+  uint32_t width = argc > 2 ? std::atoi(argv[2]) : 1280;
+  uint32_t height = argc > 3 ? std::atoi(argv[3]) : 720;
+  int loops = argc > 4 ? std::atoi(argv[4]) : 1;
+
+  Dusk::Replayer replayer(argv[1]);
+  if (!replayer) {
+    return 1;
+  }
+
+  wgpu::InstanceDescriptor instanceDesc{};
+  instanceDesc.features.timedWaitAnyEnable = true;
+  wgpu::Instance instance = wgpu::CreateInstance(&instanceDesc);
+
+  wgpu::Device device = Dusk::requestDevice(instance);
+  if (!device) {
+    return 1;
+  }
+
+  Dusk::Drawer drawer(device, wgpu::TextureFormat::BGRA8Unorm, width,
+                      height);
+
+  auto waitIdle = [&]() {
+    wgpu::QueueWorkDoneCallbackInfo callbackInfo{};
+    callbackInfo.mode = wgpu::CallbackMode::WaitAnyOnly;
+    callbackInfo.callback = []([[maybe_unused]] WGPUQueueWorkDoneStatus status,
+                               [[maybe_unused]] void* userdata) {};
+    instance.WaitAny(device.GetQueue().OnSubmittedWorkDone(callbackInfo),
+                     UINT64_MAX);
+  };
+
+  for (int loop = 0; loop < loops; loop++) {
+    replayer.rewind();
+    auto start = std::chrono::steady_clock::now();
+    while (replayer.next(drawer)) {
+      // keep the queue from growing without bound
+      if (replayer.getFrame() % 64 == 0) {
+        waitIdle();
+      }
+    }
+    waitIdle();
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    uint64_t frames = replayer.getFrame();
+    std::cout << std::format(
+                     "{} frames in {:.1f} ms, {:.3f} ms/frame, {:.1f} fps",
+                     frames, elapsed.count(), elapsed.count() / frames,
+                     frames * 1000.0 / elapsed.count())
+              << std::endl;
+  }
+}
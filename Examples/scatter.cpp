@@ -0,0 +1,51 @@
+#include <Dusk/App.hpp>
+#include <Dusk/Points.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+class Scatter : public Dusk::App {
+  static constexpr size_t COUNT = 1000000;
+
+  Dusk::Points points;
+  std::vector<glm::vec2> seeds;
+  std::vector<glm::vec2> positions;
+  std::vector<uint32_t> colors;
+
+  void setup() {
+    std::mt19937 rng(1);
+    std::normal_distribution<float> normal(0, 1);
+    for (size_t i = 0; i < COUNT; i++) {
+      glm::vec2 p(normal(rng), normal(rng));
+      seeds.push_back(p);
+      float d = std::min(glm::length(p) / 3.0f, 1.0f);
+      colors.push_back(
+          Dusk::Points::rgba8({0.3f + d * 0.7f, 0.5f, 1.0f - d, 0.5f}));
+    }
+    positions.resize(COUNT);
+    points.positions(positions).colors(colors).size(1.5);
+  }
+
+  void draw() {
+    float t = static_cast<float>(glfwGetTime());
+    glm::vec2 center = getCenter();
+    float spread = getHeight() * 0.15;
+    for (size_t i = 0; i < COUNT; i++) {
+      const glm::vec2& s = seeds[i];
+      float angle = t * 0.2f / (1.0f + glm::length(s));
+      float c = std::cos(angle);
+      float n = std::sin(angle);
+      positions[i] = center + glm::vec2(s.x * c - s.y * n, s.x * n + s.y * c) *
+                                  spread;
+    }
+
+    drawer.clear(0);
+    drawer.add(points);
+    drawer.draw();
+  }
+};
+
+int main() {
+  Scatter app;
+  app.run();
+}
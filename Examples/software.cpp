@@ -0,0 +1,68 @@
+// Draws an animation on the CPU, without a GPU or a window, reports the
+// timings and writes the last frame to a PPM image.
+//
+//   software [width] [height] [frames] [output.ppm]
+
+#include <Dusk/Drawer.hpp>
+#include <Dusk/SoftwareRasterizer.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+int main(int argc, char** argv) {
+  uint32_t width = argc > 1 ? std::atoi(argv[1]) : 1280;
+  uint32_t height = argc > 2 ? std::atoi(argv[2]) : 720;
+  int frames = argc > 3 ? std::atoi(argv[3]) : 120;
+  const char* output = argc > 4 ? argv[4] : "software.ppm";
+
+  auto rasterizer = std::make_shared<Dusk::SoftwareRasterizer>(4);
+  Dusk::Drawer drawer(rasterizer, width, height);
+
+  // the circles go in as one batch, only their centers move
+  constexpr int CIRCLES = 2000;
+  std::vector<glm::vec2> centers(CIRCLES);
+  std::vector<float> radii(CIRCLES);
+  std::vector<glm::vec4> colors(CIRCLES);
+  for (int i = 0; i < CIRCLES; i++) {
+    radii[i] = 4 + i % 7;
+    colors[i] = {0.5f + 0.5f * sinf(i * 0.1f), 0.6f, 1 - (i % 50) / 50.0f, 1};
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (int frame = 0; frame < frames; frame++) {
+    float t = frame / 60.0f;
+    drawer.clear(0.1);
+    for (int i = 0; i < CIRCLES; i++) {
+      float a = t + i * 0.0314f;
+      float r = 40 + (i % 50) * 6;
+      centers[i] = {width * 0.5f + cosf(a) * r,
+                    height * 0.5f + sinf(a * 1.1f) * r};
+    }
+    drawer.circles(centers, radii, colors);
+    drawer.push();
+    drawer.translate(width * 0.5f, height * 0.5f);
+    drawer.rotate(t);
+    drawer.rect().xy(-100, -100).wh(200, 200).rgba(1, 1, 1, 0.8);
+    drawer.pop();
+    drawer.draw();
+  }
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::cout << std::format("{} frames in {:.1f} ms, {:.3f} ms/frame", frames,
+                           elapsed.count(), elapsed.count() / frames)
+            << std::endl;
+
+  std::ofstream file(output, std::ios::binary);
+  file << "P6\n" << width << " " << height << "\n255\n";
+  for (uint32_t pixel : rasterizer->getPixels()) {
+    char rgb[3] = {static_cast<char>(pixel & 0xff),
+                   static_cast<char>((pixel >> 8) & 0xff),
+                   static_cast<char>((pixel >> 16) & 0xff)};
+    file.write(rgb, 3);
+  }
+}
@@ -0,0 +1,58 @@
+// Plays raw RGBA8 frames as a background behind animated shapes. Convert a
+// video or image sequence once with
+//
+//   ffmpeg -i in.mp4 -vf scale=1280:720 -f rawvideo -pix_fmt rgba out.rgba
+//
+// then run
+//
+//   stream out.rgba 1280 720 [fps]
+
+#include <Dusk/App.hpp>
+#include <Dusk/StreamingTexture.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+class Stream : public Dusk::App {
+ public:
+  std::unique_ptr<Dusk::StreamingTexture> background;
+  double frameRate = 30;
+
+ private:
+  void draw() {
+    drawer.clear(0);
+    double t = glfwGetTime();
+    background->frame(static_cast<uint64_t>(t * frameRate))
+        .rect(0, 0, getWidth(), getHeight());
+    drawer.add(*background);
+
+    // queued after the frame, so drawn over it
+    for (int i = 0; i < 12; i++) {
+      float a = static_cast<float>(t) + i * 0.5236f;
+      drawer.circle()
+          .xy(getCenter() + glm::vec2(cosf(a), sinf(a)) * 200.0f)
+          .radius(20)
+          .rgba(1, 0.8, 0.2);
+    }
+    drawer.draw();
+  }
+};
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    std::cerr << "usage: stream <frames.rgba> <width> <height> [fps]"
+              << std::endl;
+    return 1;
+  }
+  Stream app;
+  app.background = std::make_unique<Dusk::StreamingTexture>(
+      argv[1], std::atoi(argv[2]), std::atoi(argv[3]));
+  if (!*app.background) {
+    return 1;
+  }
+  if (argc > 4) {
+    app.frameRate = std::atof(argv[4]);
+  }
+  app.run();
+}
@@ -0,0 +1,53 @@
+#include <Dusk/App.hpp>
+#include <thread>
+#include <vector>
+
+// Each worker fills a command list of its own, the drawer draws them in
+// list order once all of them are done.
+class Threads : public Dusk::App {
+  static constexpr int WORKERS = 4;
+  static constexpr int RINGS_PER_WORKER = 16;
+  static constexpr int DOTS_PER_RING = 256;
+
+  void setup() {
+    drawer.enableAdaptiveResolution();
+    // created up front, before any worker touches them
+    drawer.commandList(WORKERS - 1);
+  }
+
+  void draw() {
+    drawer.clear(0);
+    float t = static_cast<float>(glfwGetTime());
+    glm::vec2 center = getCenter();
+
+    std::vector<std::jthread> workers;
+    for (int w = 0; w < WORKERS; w++) {
+      workers.emplace_back([&, w]() {
+        Dusk::CommandList& list = drawer.commandList(w);
+        list.translate(center);
+        for (int r = 0; r < RINGS_PER_WORKER; r++) {
+          int ring = w * RINGS_PER_WORKER + r;
+          float radius = 20.0f + ring * 5.0f;
+          list.push();
+          list.rotate(t * (0.1f + ring * 0.01f));
+          for (int i = 0; i < DOTS_PER_RING; i++) {
+            float a = i * 6.2831853f / DOTS_PER_RING;
+            list.circle()
+                .xy(cosf(a) * radius, sinf(a) * radius)
+                .radius(1.5)
+                .rgba(0.3 + w * 0.2, 0.6, 1.0 - w * 0.2);
+          }
+          list.pop();
+        }
+      });
+    }
+    workers.clear();
+
+    drawer.draw();
+  }
+};
+
+int main() {
+  Threads app;
+  app.run();
+}
@@ -0,0 +1,65 @@
+// Draws one frame far larger than a texture can be, tile by tile into a PPM
+// image, e.g. for print. Only a tile is ever held in memory.
+//
+//   tiled [width] [height] [tile size] [output.ppm]
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <Dusk/Device.hpp>
+#include <Dusk/Drawer.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <numbers>
+#include <vector>
+
+int main(int argc, char** argv) {
+  uint32_t width = argc > 1 ? std::atoi(argv[1]) : 20000;
+  uint32_t height = argc > 2 ? std::atoi(argv[2]) : 20000;
+  uint32_t tile = argc > 3 ? std::atoi(argv[3]) : 4096;
+  const char* output = argc > 4 ? argv[4] : "tiled.ppm";
+
+  wgpu::InstanceDescriptor instanceDesc{};
+  instanceDesc.features.timedWaitAnyEnable = true;
+  wgpu::Instance instance = wgpu::CreateInstance(&instanceDesc);
+
+  wgpu::Device device = Dusk::requestDevice(instance);
+  if (!device) {
+    return 1;
+  }
+
+  Dusk::Drawer drawer(device, wgpu::TextureFormat::RGBA8Unorm, tile, tile);
+  // curves stay smooth at the image's resolution
+  drawer.enableAdaptiveResolution();
+
+  // a spiral of circles across the whole image, in image pixels
+  constexpr int CIRCLES = 200000;
+  std::vector<glm::vec2> centers(CIRCLES);
+  std::vector<float> radii(CIRCLES);
+  std::vector<glm::vec4> colors(CIRCLES);
+  const glm::vec2 center(width * 0.5f, height * 0.5f);
+  const float extent = std::min(width, height) * 0.5f;
+  for (int i = 0; i < CIRCLES; i++) {
+    float id = static_cast<float>(i) / CIRCLES;
+    float angle = i * std::numbers::pi_v<float> * (3 - std::sqrt(5.0f));
+    float r = std::sqrt(id) * extent;
+    centers[i] = center + glm::vec2(std::cos(angle), std::sin(angle)) * r;
+    radii[i] = 2 + id * extent * 0.01f;
+    colors[i] = {id, 0.4f + 0.6f * std::sin(angle) * std::sin(angle),
+                 1 - id, 1};
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  drawer.clear(0.02);
+  drawer.circles(centers, radii, colors);
+  if (!drawer.drawTiled(output, width, height)) {
+    return 1;
+  }
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::cout << std::format("{}x{} px in {:.1f} ms", width, height,
+                           elapsed.count())
+            << std::endl;
+}
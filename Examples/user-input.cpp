@@ -2,9 +2,29 @@
 #include <iostream>
 
 class UserInput : public Dusk::App {
+ public:
+  UserInput() {
+    setInputMode(Dusk::InputMode::Queued);
+    // every drag position, not just the last of each frame, so a fast
+    // stroke stays a continuous line
+    events().setCoalesceMoves(false);
+  }
+
+  // keeps the strokes across frames and window resizes, redrawing only
+  // where new ones land
+  Dusk::Canvas canvas;
+
+  void setup() {
+    drawer.setCanvas(&canvas);
+  }
+
+  void draw() {
+    dispatchEvents();
+    drawer.draw();
+  }
+
   void onMouseDragged(double mouseX, double mouseY) {
     drawer.circle().xy(mouseX, mouseY).radius(15);
-    drawer.draw();
   }
 
   void onMousePressed(double mouseX, double mouseY, int button) {
@@ -18,7 +38,6 @@ class UserInput : public Dusk::App {
   void onKeyPressed(int key) {
     if (key == GLFW_KEY_C) {
       drawer.clear(0);
-      drawer.draw();
     }
   }
 };
@@ -26,4 +45,4 @@ class UserInput : public Dusk::App {
 int main() {
   UserInput app;
   app.run();
-}
\ No newline at end of file
+}